@@ -13,4 +13,25 @@ if nats stream info "$STREAM_NAME" --server="$SERVER_URL" > /dev/null 2>&1; then
 else
   echo "🆕 Creating KV bucket '$BUCKET'..."
   nats kv add "$BUCKET" --server="$SERVER_URL" --marker-ttl "1y"
-fi
\ No newline at end of file
+fi
+
+DURABLE_STREAM="rabbit-telemetry"
+
+if nats stream info "$DURABLE_STREAM" --server="$SERVER_URL" > /dev/null 2>&1; then
+  echo "Stream '$DURABLE_STREAM' already exists"
+else
+  echo "🆕 Creating durable telemetry stream '$DURABLE_STREAM'..."
+  # Durable tier: low-rate telemetry we may want to replay after a crash.
+  # Tight limits keep the on-disk footprint bounded; high-rate sensor
+  # subjects (frames, depth, joy) deliberately stay off JetStream.
+  nats stream add "$DURABLE_STREAM" \
+    --server="$SERVER_URL" \
+    --subjects "rabbit.power.telemetry" \
+    --storage file \
+    --retention limits \
+    --max-age 24h \
+    --max-bytes 256MB \
+    --max-msgs 500000 \
+    --discard old \
+    --defaults
+fi
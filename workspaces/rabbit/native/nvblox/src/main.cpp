@@ -0,0 +1,527 @@
+// Standalone native nvblox node.
+//
+// The Python node (src/node/nvblox.py) spends the per-frame budget inside the
+// interpreter: JPEG decode, u16-to-float depth conversion and tensor staging
+// all run before a single voxel is touched. This node keeps Python off the
+// per-frame path entirely: cnats for transport, OpenCV for JPEG, LZ4F for
+// depth and the nvblox C++ core — the same libnvblox_lib.so that nvblox_torch
+// wraps — for integration and meshing.
+//
+// Wire compatibility with the Python node:
+//   in : rabbit.zed.depth     DEPTH_MM_U16_LZ4 payload, w/h/frame_number headers
+//        rabbit.zed.frame     JPEG payload, frame_number header
+//        rabbit.zed.pose_bin  POSE_STRUCT "<3f4fIq" (40 bytes)
+//        KV rabbit.zed.intrinsics (JSON, read once at startup)
+//   out: rabbit.nvblox.mesh.bin  MESH_HEADER + vertices/colors/triangles,
+//        byte-identical to the object-store blob written by the Python node.
+//        The C client has no object-store API, so the mesh goes out as a core
+//        message instead (max_payload is raised in nats-server.conf) and the
+//        web viewer consumes both forms.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cuda_runtime.h>
+#include <lz4frame.h>
+#include <nats/nats.h>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "nvblox/mapper/mapper.h"
+#include "nvblox/sensors/camera.h"
+#include "nvblox/sensors/image.h"
+
+namespace {
+
+// Mirrors the constants in src/node/nvblox.py
+constexpr float kMinDepth = 0.1f;
+constexpr float kMaxDepth = 10.0f;
+constexpr float kVoxelSize = 0.05f;
+constexpr float kMaxIntegrationDistance = 5.0f;
+constexpr int kSyncBufferFrames = 8;
+constexpr int kMeshPublishPeriodS = 5;
+
+constexpr const char* kNatsUrl = "nats://nats:4222";
+constexpr const char* kMeshSubject = "rabbit.nvblox.mesh.bin";
+
+struct PoseSample {
+  float translation[3];
+  float orientation[4];  // x, y, z, w
+  uint32_t frame_number;
+  int64_t timestamp;
+};
+
+struct DepthFrame {
+  int width = 0;
+  int height = 0;
+  // Pre-crop retrieve resolution and ROI origin from the zed headers: the
+  // camera intrinsics are scaled by the former and the principal point is
+  // shifted by the latter before integration
+  int full_width = 0;
+  int full_height = 0;
+  int roi_x = 0;
+  int roi_y = 0;
+  std::vector<float> meters;  // row-major, invalid depth already zeroed
+};
+
+// Synchronization stage, same policy as Node._store_synced in nvblox.py:
+// small per-stream ring buffers keyed by the zed frame counter, bundle on
+// the highest frame number present in both the depth and pose streams.
+// RGB is matched to the nearest buffered frame instead of required — the
+// JPEG stream is decimated while H.264 is active, and an exact-match
+// requirement would cap depth integration at the JPEG rate.
+class FrameSync {
+ public:
+  struct Bundle {
+    uint32_t frame_number;
+    DepthFrame depth;
+    cv::Mat rgb;
+    PoseSample pose;
+  };
+
+  void putDepth(uint32_t frame, DepthFrame&& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    depth_[frame] = std::move(value);
+    trim(depth_);
+    match();
+  }
+
+  void putRgb(uint32_t frame, cv::Mat&& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rgb_[frame] = std::move(value);
+    trim(rgb_);
+    match();
+  }
+
+  void putPose(const PoseSample& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pose_[value.frame_number] = value;
+    trim(pose_);
+    match();
+  }
+
+  std::optional<Bundle> take() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::optional<Bundle> out = std::move(bundle_);
+    bundle_.reset();
+    return out;
+  }
+
+  uint64_t takeDrops() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t out = drops_;
+    drops_ = 0;
+    return out;
+  }
+
+ private:
+  template <typename M>
+  void trim(M& buffer) {
+    while (buffer.size() > kSyncBufferFrames) {
+      buffer.erase(buffer.begin());
+      drops_++;
+    }
+  }
+
+  template <typename M>
+  void dropOlder(M& buffer, uint32_t frame) {
+    while (!buffer.empty() && buffer.begin()->first < frame) {
+      buffer.erase(buffer.begin());
+      drops_++;
+    }
+  }
+
+  // Nearest buffered RGB within kSyncBufferFrames of the given frame, or an
+  // empty Mat when none qualifies. Returns a shallow copy and leaves the
+  // entry buffered so it can color the bundles between JPEG arrivals;
+  // trim() keeps the buffer bounded.
+  cv::Mat nearestRgb(uint32_t frame) {
+    auto ge = rgb_.lower_bound(frame);
+    auto best = rgb_.end();
+    uint32_t best_gap = 0;
+    if (ge != rgb_.end()) {
+      best = ge;
+      best_gap = ge->first - frame;
+    }
+    if (ge != rgb_.begin()) {
+      auto lt = std::prev(ge);
+      const uint32_t gap = frame - lt->first;
+      if (best == rgb_.end() || gap < best_gap) {
+        best = lt;
+        best_gap = gap;
+      }
+    }
+    if (best == rgb_.end() ||
+        best_gap > static_cast<uint32_t>(kSyncBufferFrames)) {
+      return cv::Mat();
+    }
+    return best->second;
+  }
+
+  void match() {
+    // Walk the (sorted) depth frames from newest to oldest and take the
+    // first one that also has a pose; an empty rgb makes a depth-only
+    // bundle and the integration loop skips the color frame
+    for (auto it = depth_.rbegin(); it != depth_.rend(); ++it) {
+      const uint32_t frame = it->first;
+      auto pose = pose_.find(frame);
+      if (pose == pose_.end()) {
+        continue;
+      }
+
+      cv::Mat rgb = nearestRgb(frame);
+      bundle_ =
+          Bundle{frame, std::move(it->second), std::move(rgb), pose->second};
+      depth_.erase(frame);
+      pose_.erase(pose);
+      dropOlder(depth_, frame);
+      dropOlder(pose_, frame);
+      return;
+    }
+  }
+
+  std::mutex mutex_;
+  std::map<uint32_t, DepthFrame> depth_;
+  std::map<uint32_t, cv::Mat> rgb_;
+  std::map<uint32_t, PoseSample> pose_;
+  std::optional<Bundle> bundle_;
+  uint64_t drops_ = 0;
+};
+
+FrameSync g_sync;
+LZ4F_dctx* g_lz4_ctx = nullptr;
+
+int64_t headerInt(natsMsg* msg, const char* key, int64_t fallback) {
+  const char* value = nullptr;
+  if (natsMsgHeader_Get(msg, key, &value) != NATS_OK || value == nullptr) {
+    return fallback;
+  }
+  return strtoll(value, nullptr, 10);
+}
+
+// Minimal extraction of a numeric field from the intrinsics JSON; the
+// payload is produced by our own zed node, not arbitrary input
+double jsonNumber(const std::string& json, const char* key) {
+  std::string needle = std::string("\"") + key + "\":";
+  size_t pos = json.find(needle);
+  if (pos == std::string::npos) {
+    fprintf(stderr, "intrinsics JSON missing field %s\n", key);
+    exit(1);
+  }
+  return strtod(json.c_str() + pos + needle.size(), nullptr);
+}
+
+void onDepth(natsConnection*, natsSubscription*, natsMsg* msg, void*) {
+  const int64_t frame = headerInt(msg, "frame_number", -1);
+  const int width = (int)headerInt(msg, "w", 0);
+  const int height = (int)headerInt(msg, "h", 0);
+  if (frame < 0 || width <= 0 || height <= 0) {
+    natsMsg_Destroy(msg);
+    return;
+  }
+
+  const size_t pixels = (size_t)width * height;
+  std::vector<uint16_t> millimeters(pixels);
+
+  size_t dst_size = pixels * sizeof(uint16_t);
+  size_t src_size = natsMsg_GetDataLength(msg);
+  size_t result = LZ4F_decompress(g_lz4_ctx, millimeters.data(), &dst_size,
+                                  natsMsg_GetData(msg), &src_size, nullptr);
+  if (LZ4F_isError(result) || dst_size != pixels * sizeof(uint16_t)) {
+    LZ4F_resetDecompressionContext(g_lz4_ctx);
+    natsMsg_Destroy(msg);
+    return;
+  }
+
+  DepthFrame out;
+  out.width = width;
+  out.height = height;
+  out.full_width = (int)headerInt(msg, "full_w", width);
+  out.full_height = (int)headerInt(msg, "full_h", height);
+  out.roi_x = (int)headerInt(msg, "roi_x", 0);
+  out.roi_y = (int)headerInt(msg, "roi_y", 0);
+  out.meters.resize(pixels);
+  for (size_t i = 0; i < pixels; i++) {
+    const float meters = millimeters[i] * 0.001f;
+    out.meters[i] = (meters > kMinDepth && meters < kMaxDepth) ? meters : 0.0f;
+  }
+
+  g_sync.putDepth((uint32_t)frame, std::move(out));
+  natsMsg_Destroy(msg);
+}
+
+void onRgb(natsConnection*, natsSubscription*, natsMsg* msg, void*) {
+  const int64_t frame = headerInt(msg, "frame_number", -1);
+  if (frame < 0) {
+    natsMsg_Destroy(msg);
+    return;
+  }
+
+  cv::Mat encoded(1, natsMsg_GetDataLength(msg), CV_8UC1,
+                  (void*)natsMsg_GetData(msg));
+  cv::Mat bgr = cv::imdecode(encoded, cv::IMREAD_COLOR);
+  natsMsg_Destroy(msg);
+  if (bgr.empty()) {
+    return;
+  }
+
+  cv::Mat rgb;
+  cv::cvtColor(bgr, rgb, cv::COLOR_BGR2RGB);
+  g_sync.putRgb((uint32_t)frame, std::move(rgb));
+}
+
+void onPose(natsConnection*, natsSubscription*, natsMsg* msg, void*) {
+  if (natsMsg_GetDataLength(msg) != 40) {
+    natsMsg_Destroy(msg);
+    return;
+  }
+
+  PoseSample pose;
+  const char* data = natsMsg_GetData(msg);
+  memcpy(pose.translation, data, 12);
+  memcpy(pose.orientation, data + 12, 16);
+  memcpy(&pose.frame_number, data + 28, 4);
+  memcpy(&pose.timestamp, data + 32, 8);
+  natsMsg_Destroy(msg);
+
+  g_sync.putPose(pose);
+}
+
+nvblox::Transform poseToTransform(const PoseSample& pose) {
+  Eigen::Quaternionf q(pose.orientation[3], pose.orientation[0],
+                       pose.orientation[1], pose.orientation[2]);
+  nvblox::Transform t = nvblox::Transform::Identity();
+  t.linear() = q.toRotationMatrix();
+  t.translation() << pose.translation[0], pose.translation[1],
+      pose.translation[2];
+  return t;
+}
+
+// MESH_HEADER "<4sBxxxIII" + f32 vertices + u8 colors + u32 triangles;
+// byte-identical to publish_mesh in nvblox.py
+void publishMesh(natsConnection* conn, nvblox::Mapper& mapper,
+                 uint32_t sequence) {
+  mapper.updateMesh();
+  const nvblox::MeshLayer& layer = mapper.mesh_layer();
+
+  std::vector<float> vertices;
+  std::vector<uint8_t> colors;
+  std::vector<uint32_t> triangles;
+
+  for (const nvblox::Index3D& index : layer.getAllBlockIndices()) {
+    const auto block = layer.getBlockAtIndex(index);
+    if (!block) {
+      continue;
+    }
+
+    const auto block_vertices = block->getVertexVectorOnCPU();
+    const auto block_colors = block->getColorVectorOnCPU();
+    const auto block_triangles = block->getTriangleVectorOnCPU();
+    const uint32_t base = (uint32_t)(vertices.size() / 3);
+
+    for (const auto& v : block_vertices) {
+      vertices.push_back(v.x());
+      vertices.push_back(v.y());
+      vertices.push_back(v.z());
+    }
+    for (const auto& c : block_colors) {
+      colors.push_back(c.r);
+      colors.push_back(c.g);
+      colors.push_back(c.b);
+    }
+    for (int t : block_triangles) {
+      triangles.push_back(base + (uint32_t)t);
+    }
+  }
+
+  const uint32_t vertex_count = (uint32_t)(vertices.size() / 3);
+  const uint32_t triangle_count = (uint32_t)(triangles.size() / 3);
+  if (vertex_count == 0) {
+    return;
+  }
+
+  std::vector<uint8_t> payload;
+  payload.reserve(20 + vertices.size() * 4 + colors.size() + triangles.size() * 4);
+
+  const uint8_t header[8] = {'M', 'E', 'S', 'H', 1, 0, 0, 0};
+  payload.insert(payload.end(), header, header + 8);
+  auto append = [&payload](const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    payload.insert(payload.end(), bytes, bytes + size);
+  };
+  append(&sequence, 4);
+  append(&vertex_count, 4);
+  append(&triangle_count, 4);
+  append(vertices.data(), vertices.size() * 4);
+  append(colors.data(), colors.size());
+  append(triangles.data(), triangles.size() * 4);
+
+  natsStatus status = natsConnection_Publish(conn, kMeshSubject,
+                                             payload.data(), (int)payload.size());
+  if (status != NATS_OK) {
+    fprintf(stderr, "mesh publish failed: %s\n", natsStatus_GetText(status));
+    return;
+  }
+
+  printf("published mesh %u: %u vertices, %u triangles (%zu bytes)\n",
+         sequence, vertex_count, triangle_count, payload.size());
+}
+
+}  // namespace
+
+int main() {
+  LZ4F_createDecompressionContext(&g_lz4_ctx, LZ4F_VERSION);
+
+  natsConnection* conn = nullptr;
+  natsOptions* opts = nullptr;
+  natsOptions_Create(&opts);
+  natsOptions_SetURL(opts, kNatsUrl);
+  natsOptions_SetName(opts, "nvblox-native");
+  natsOptions_SetMaxReconnect(opts, -1);
+  natsOptions_SetReconnectWait(opts, 2000);
+
+  natsStatus status = natsConnection_Connect(&conn, opts);
+  if (status != NATS_OK) {
+    fprintf(stderr, "NATS connect failed: %s\n", natsStatus_GetText(status));
+    return 1;
+  }
+
+  // Intrinsics are published once by the zed node into the KV bucket
+  jsCtx* js = nullptr;
+  kvStore* kv = nullptr;
+  kvEntry* entry = nullptr;
+  natsConnection_JetStream(&js, conn, nullptr);
+  if (js_KeyValue(&kv, js, "rabbit") != NATS_OK ||
+      kvStore_Get(&entry, kv, "rabbit.zed.intrinsics") != NATS_OK) {
+    fprintf(stderr, "camera intrinsics not found in KeyValue store\n");
+    return 1;
+  }
+
+  std::string intrinsics_json((const char*)kvEntry_Value(entry),
+                              kvEntry_ValueLen(entry));
+  kvEntry_Destroy(entry);
+
+  const nvblox::Camera camera(
+      (float)jsonNumber(intrinsics_json, "fx"),
+      (float)jsonNumber(intrinsics_json, "fy"),
+      (float)jsonNumber(intrinsics_json, "cx"),
+      (float)jsonNumber(intrinsics_json, "cy"),
+      (int)jsonNumber(intrinsics_json, "width"),
+      (int)jsonNumber(intrinsics_json, "height"));
+  printf("loaded camera intrinsics: %dx%d\n", camera.width(), camera.height());
+
+  nvblox::Mapper mapper(kVoxelSize, nvblox::MemoryType::kDevice);
+  mapper.tsdf_integrator().max_integration_distance_m(kMaxIntegrationDistance);
+  mapper.color_integrator().max_integration_distance_m(kMaxIntegrationDistance);
+
+  natsSubscription* depth_sub = nullptr;
+  natsSubscription* rgb_sub = nullptr;
+  natsSubscription* pose_sub = nullptr;
+  natsConnection_Subscribe(&depth_sub, conn, "rabbit.zed.depth", onDepth, nullptr);
+  natsConnection_Subscribe(&rgb_sub, conn, "rabbit.zed.frame", onRgb, nullptr);
+  natsConnection_Subscribe(&pose_sub, conn, "rabbit.zed.pose_bin", onPose, nullptr);
+
+  // Callback threads only decode and buffer; integration and meshing stay on
+  // this thread so the mapper is touched from a single place
+  nvblox::DepthImage depth_image(camera.height(), camera.width(),
+                                 nvblox::MemoryType::kDevice);
+  nvblox::ColorImage color_image(camera.height(), camera.width(),
+                                 nvblox::MemoryType::kDevice);
+
+  // Depth usually arrives below camera resolution (DEPTH_WIDTH x DEPTH_HEIGHT
+  // in zed.py, reconfigurable over KV) and may be ROI-cropped; keep a staging
+  // image and adjusted intrinsics for whatever shape is currently streaming
+  std::unique_ptr<nvblox::DepthImage> scaled_depth;
+  std::unique_ptr<nvblox::Camera> scaled_camera;
+  DepthFrame scaled_shape;  // geometry the staging image/camera were built for
+
+  using clock = std::chrono::steady_clock;
+  auto last_mesh = clock::now();
+  auto last_report = clock::now();
+  uint32_t sequence = 0;
+  uint64_t integrated = 0;
+
+  while (true) {
+    auto bundle = g_sync.take();
+    if (!bundle) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    } else {
+      const DepthFrame& depth = bundle->depth;
+      const bool full_frame = depth.width == camera.width() &&
+                              depth.height == camera.height() &&
+                              depth.roi_x == 0 && depth.roi_y == 0;
+      if (!full_frame) {
+        if (!scaled_depth || scaled_shape.width != depth.width ||
+            scaled_shape.height != depth.height ||
+            scaled_shape.full_width != depth.full_width ||
+            scaled_shape.full_height != depth.full_height ||
+            scaled_shape.roi_x != depth.roi_x ||
+            scaled_shape.roi_y != depth.roi_y) {
+          // Scale by the pre-crop retrieve resolution (not the frame size,
+          // which is the ROI size when cropping is on) and shift the
+          // principal point by the crop origin
+          const float sx = (float)depth.full_width / camera.width();
+          const float sy = (float)depth.full_height / camera.height();
+          scaled_camera = std::make_unique<nvblox::Camera>(
+              camera.fu() * sx, camera.fv() * sy,
+              camera.cu() * sx - depth.roi_x, camera.cv() * sy - depth.roi_y,
+              depth.width, depth.height);
+          scaled_depth = std::make_unique<nvblox::DepthImage>(
+              depth.height, depth.width, nvblox::MemoryType::kDevice);
+          scaled_shape = depth;
+          scaled_shape.meters.clear();
+        }
+
+        cudaMemcpy(scaled_depth->dataPtr(), depth.meters.data(),
+                   depth.meters.size() * sizeof(float), cudaMemcpyHostToDevice);
+        mapper.integrateDepth(*scaled_depth, poseToTransform(bundle->pose),
+                              *scaled_camera);
+      } else {
+        cudaMemcpy(depth_image.dataPtr(), depth.meters.data(),
+                   depth.meters.size() * sizeof(float), cudaMemcpyHostToDevice);
+        mapper.integrateDepth(depth_image, poseToTransform(bundle->pose),
+                              camera);
+      }
+
+      if (bundle->rgb.cols == camera.width() &&
+          bundle->rgb.rows == camera.height()) {
+        cv::Mat rgba;
+        cv::cvtColor(bundle->rgb, rgba, cv::COLOR_RGB2RGBA);
+        cudaMemcpy(color_image.dataPtr(), rgba.data,
+                   (size_t)rgba.total() * rgba.elemSize(),
+                   cudaMemcpyHostToDevice);
+        mapper.integrateColor(color_image, poseToTransform(bundle->pose),
+                              camera);
+      }
+
+      integrated++;
+    }
+
+    const auto now = clock::now();
+    if (now - last_mesh > std::chrono::seconds(kMeshPublishPeriodS)) {
+      last_mesh = now;
+      publishMesh(conn, mapper, ++sequence);
+    }
+
+    if (now - last_report > std::chrono::seconds(10)) {
+      const double elapsed =
+          std::chrono::duration<double>(now - last_report).count();
+      printf("integrated %.1f fps, sync dropped %llu frames\n",
+             integrated / elapsed, (unsigned long long)g_sync.takeDrops());
+      last_report = now;
+      integrated = 0;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+"""Builds the Cython extensions used by the nodes.
+
+The compose stack mounts ./rabbit over /rabbit, which would hide anything
+built in-tree, so the Dockerfiles build these to /opt/rabbit and put it on
+PYTHONPATH — src/lib has no __init__.py, so lib/ merges as a namespace
+package and the compiled modules sit next to their pure-Python fallbacks:
+
+    python3 setup.py build_ext --build-lib /opt/rabbit
+"""
+
+import numpy
+from Cython.Build import cythonize
+from setuptools import Extension, setup
+
+setup(
+    name="rabbit-ext",
+    ext_modules=cythonize(
+        [
+            Extension(
+                "lib.depth_pack",
+                ["src/lib/depth_pack.pyx"],
+                include_dirs=[numpy.get_include()],
+            ),
+            Extension("lib.crc16", ["src/lib/crc16.pyx"]),
+        ],
+        language_level=3,
+    ),
+)
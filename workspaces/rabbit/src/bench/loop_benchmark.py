@@ -0,0 +1,123 @@
+"""Event loop benchmark for RabbitNode's tick scheduler.
+
+Runs a synthetic node on the default asyncio loop and on uvloop (when
+installed) and reports tick jitter against set_interval's fixed schedule,
+callback dispatch latency and NATS publish throughput. NATS measurements are
+skipped when no server is reachable.
+
+Usage: python bench/loop_benchmark.py [--duration 10] [--rate 30]
+"""
+
+import argparse
+import asyncio
+import time
+from typing import List, Optional
+
+import nats
+
+try:
+    import uvloop
+except ImportError:
+    uvloop = None
+
+
+def percentiles(samples: List[float]) -> str:
+    values = sorted(samples)
+
+    def pct(p: float) -> float:
+        return values[min(len(values) - 1, int(len(values) * p))]
+
+    return (
+        f"mean={sum(values) / len(values) * 1000:.3f}ms "
+        f"p50={pct(0.50) * 1000:.3f}ms "
+        f"p95={pct(0.95) * 1000:.3f}ms "
+        f"p99={pct(0.99) * 1000:.3f}ms "
+        f"max={values[-1] * 1000:.3f}ms"
+    )
+
+
+async def measure_tick_jitter(rate: float, duration: float) -> List[float]:
+    """Absolute deviation from set_interval's fixed next_tick schedule."""
+    delay = 1 / rate
+    jitter: List[float] = []
+    loop = asyncio.get_running_loop()
+    next_tick = loop.time()
+    deadline = loop.time() + duration
+
+    while loop.time() < deadline:
+        next_tick += delay
+        sleep_time = next_tick - loop.time()
+        await asyncio.sleep(sleep_time if sleep_time > 0 else 0)
+        jitter.append(abs(loop.time() - next_tick))
+
+    return jitter
+
+
+async def measure_callback_latency(samples: int) -> List[float]:
+    """Time from create_task to the callback's first instruction."""
+    latencies: List[float] = []
+
+    for _ in range(samples):
+        scheduled = time.perf_counter()
+
+        async def callback():
+            latencies.append(time.perf_counter() - scheduled)
+
+        await asyncio.create_task(callback())
+
+    return latencies
+
+
+async def measure_publish_throughput(duration: float) -> Optional[float]:
+    try:
+        nc = await nats.connect("nats://nats:4222", name="loop-benchmark")
+    except Exception:
+        return None
+
+    payload = b"x" * 64
+    published = 0
+    deadline = time.perf_counter() + duration
+
+    while time.perf_counter() < deadline:
+        await nc.publish("rabbit.bench.loop", payload)
+        published += 1
+
+    await nc.flush()
+    await nc.close()
+    return published / duration
+
+
+async def run_benchmark(rate: float, duration: float):
+    jitter = await measure_tick_jitter(rate, duration)
+    print(f"  tick jitter @ {rate:.0f} Hz: {percentiles(jitter)}")
+
+    latency = await measure_callback_latency(samples=10_000)
+    print(f"  callback latency: {percentiles(latency)}")
+
+    throughput = await measure_publish_throughput(duration)
+    if throughput is not None:
+        print(f"  NATS publish throughput: {throughput:,.0f} msg/s")
+    else:
+        print("  NATS publish throughput: skipped (no server)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--duration", type=float, default=10.0)
+    parser.add_argument("--rate", type=float, default=30.0)
+    args = parser.parse_args()
+
+    print("asyncio default loop:")
+    asyncio.run(run_benchmark(args.rate, args.duration))
+
+    if uvloop is None:
+        print("uvloop: not installed, skipped")
+        return
+
+    uvloop.install()
+    print("uvloop:")
+    asyncio.run(run_benchmark(args.rate, args.duration))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+import pickle
+from typing import Tuple
+
+import torch
+from torch.multiprocessing.reductions import rebuild_cuda_tensor
+
+
+def export_cuda_tensor(tensor: torch.Tensor) -> bytes:
+    """Serialize a CUDA IPC handle for a tensor so another local process can map it.
+
+    The tensor must stay alive (and on the same device) in the exporting process
+    for as long as any importer uses it. Export once per allocation, not per frame.
+    """
+    if not tensor.is_cuda:
+        raise ValueError("CUDA IPC export requires a CUDA tensor")
+
+    storage = tensor._typed_storage()
+    (
+        device,
+        handle,
+        storage_size_bytes,
+        storage_offset_bytes,
+        ref_counter_handle,
+        ref_counter_offset,
+        event_handle,
+        event_sync_required,
+    ) = storage._share_cuda_()
+
+    return pickle.dumps(
+        {
+            "dtype": tensor.dtype,
+            "tensor_size": tuple(tensor.size()),
+            "tensor_stride": tuple(tensor.stride()),
+            "tensor_offset": tensor.storage_offset(),
+            "storage_device": device,
+            "storage_handle": handle,
+            "storage_size_bytes": storage_size_bytes,
+            "storage_offset_bytes": storage_offset_bytes,
+            "ref_counter_handle": ref_counter_handle,
+            "ref_counter_offset": ref_counter_offset,
+            "event_handle": event_handle,
+            "event_sync_required": event_sync_required,
+        }
+    )
+
+
+def import_cuda_tensor(data: bytes) -> torch.Tensor:
+    """Map a CUDA IPC handle exported by export_cuda_tensor into this process."""
+    fields = pickle.loads(data)
+
+    return rebuild_cuda_tensor(
+        torch.Tensor,
+        tensor_size=fields["tensor_size"],
+        tensor_stride=fields["tensor_stride"],
+        tensor_offset=fields["tensor_offset"],
+        storage_cls=torch.storage.TypedStorage,
+        dtype=fields["dtype"],
+        storage_device=fields["storage_device"],
+        storage_handle=fields["storage_handle"],
+        storage_size_bytes=fields["storage_size_bytes"],
+        storage_offset_bytes=fields["storage_offset_bytes"],
+        requires_grad=False,
+        ref_counter_handle=fields["ref_counter_handle"],
+        ref_counter_offset=fields["ref_counter_offset"],
+        event_handle=fields["event_handle"],
+        event_sync_required=fields["event_sync_required"],
+    )
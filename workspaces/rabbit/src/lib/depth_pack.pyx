@@ -0,0 +1,44 @@
+# cython: boundscheck=False, wraparound=False, cdivision=True, language_level=3
+#
+# Fused depth quantization kernel for the zed node's publish_depth path.
+# Replaces the nan_to_num / clip / scale / astype NumPy chain (four full-frame
+# passes and as many temporaries) with a single pass into a caller-owned uint16
+# buffer, so the hot path makes no allocations at all. Build with cythonize;
+# the zed node falls back to the NumPy chain when the extension is missing.
+
+from libc.math cimport isfinite
+
+import numpy as np
+
+cimport numpy as np
+
+
+def quantize_depth(
+    np.float32_t[:, ::1] src,
+    np.uint16_t[:, ::1] dst,
+    float max_depth_m,
+):
+    """Quantize a float32 depth frame in meters to uint16 millimeters.
+
+    NaN/inf and out-of-range values map to 0, everything else is clamped to
+    max_depth_m and scaled by 1000. src and dst must have identical shapes.
+    """
+    cdef Py_ssize_t rows = src.shape[0]
+    cdef Py_ssize_t cols = src.shape[1]
+
+    if dst.shape[0] != rows or dst.shape[1] != cols:
+        raise ValueError("src and dst shapes do not match")
+
+    cdef Py_ssize_t i, j
+    cdef float d
+
+    with nogil:
+        for i in range(rows):
+            for j in range(cols):
+                d = src[i, j]
+                if not isfinite(d) or d <= 0.0:
+                    dst[i, j] = 0
+                elif d >= max_depth_m:
+                    dst[i, j] = <np.uint16_t>(max_depth_m * 1000.0)
+                else:
+                    dst[i, j] = <np.uint16_t>(d * 1000.0)
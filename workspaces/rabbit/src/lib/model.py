@@ -1,3 +1,5 @@
+import struct
+
 from pydantic import BaseModel
 
 
@@ -8,6 +10,119 @@ class Pose(BaseModel):
     timestamp: int
 
 
+# Fixed-layout binary pose: translation (3f), orientation quaternion (4f),
+# frame_number (u32), timestamp ns (i64). 40 bytes, little-endian, mirrored by
+# decodePose in the web's NatsProvider.
+POSE_STRUCT = struct.Struct("<3f4fIq")
+
+
+def pack_pose(pose: Pose) -> bytes:
+    return POSE_STRUCT.pack(
+        *pose.translation[:3],
+        *pose.orientation[:4],
+        pose.frame_number & 0xFFFFFFFF,
+        pose.timestamp,
+    )
+
+
+def unpack_pose(data: bytes) -> Pose:
+    fields = POSE_STRUCT.unpack(data)
+    return Pose(
+        translation=list(fields[0:3]),
+        orientation=list(fields[3:7]),
+        frame_number=fields[7],
+        timestamp=fields[8],
+    )
+
+
+# Fixed-layout binary joystick command: left/right stick x/y as i16 scaled by
+# 32767, l2/r2 trigger values as u16 scaled by 65535, and a button bitmask in
+# JOY_BUTTONS order. 14 bytes, little-endian, mirrored by encodeJoy in the
+# web's controller/joy.ts. The JSON form stays on rabbit.cmd.joy.json for
+# debugging only.
+JOY_STRUCT = struct.Struct("<4h2HH")
+
+JOY_BUTTONS = [
+    "cross",
+    "circle",
+    "square",
+    "triangle",
+    "l1",
+    "r1",
+    "l2",
+    "r2",
+    "share",
+    "options",
+    "l3",
+    "r3",
+    "up",
+    "down",
+    "left",
+    "right",
+]
+
+
+class JoyCommand(BaseModel):
+    left_x: float
+    left_y: float
+    right_x: float
+    right_y: float
+    l2: float
+    r2: float
+    buttons: int
+
+    def pressed(self, name: str) -> bool:
+        return bool(self.buttons & (1 << JOY_BUTTONS.index(name)))
+
+
+def unpack_joy(data: bytes) -> JoyCommand:
+    lx, ly, rx, ry, l2, r2, buttons = JOY_STRUCT.unpack(data)
+    return JoyCommand(
+        left_x=lx / 32767,
+        left_y=ly / 32767,
+        right_x=rx / 32767,
+        right_y=ry / 32767,
+        l2=l2 / 65535,
+        r2=r2 / 65535,
+        buttons=buttons,
+    )
+
+
+class Odometry(BaseModel):
+    encoder_m1: int
+    encoder_m2: int
+    speed_m1: int
+    speed_m2: int
+    timestamp: int
+
+
+# Fixed-layout binary wheel odometry: both encoder counts (2i), both
+# instantaneous speeds in counts/s (2i), timestamp ns (q). 24 bytes,
+# little-endian, published at 50 Hz on rabbit.drive.odom.
+ODOM_STRUCT = struct.Struct("<4iq")
+
+
+def pack_odom(odom: Odometry) -> bytes:
+    return ODOM_STRUCT.pack(
+        odom.encoder_m1,
+        odom.encoder_m2,
+        odom.speed_m1,
+        odom.speed_m2,
+        odom.timestamp,
+    )
+
+
+def unpack_odom(data: bytes) -> Odometry:
+    enc1, enc2, speed1, speed2, timestamp = ODOM_STRUCT.unpack(data)
+    return Odometry(
+        encoder_m1=enc1,
+        encoder_m2=enc2,
+        speed_m1=speed1,
+        speed_m2=speed2,
+        timestamp=timestamp,
+    )
+
+
 class CameraIntrinsics(BaseModel):
     fx: float
     fy: float
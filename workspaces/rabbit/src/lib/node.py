@@ -1,4 +1,5 @@
 import asyncio
+import json
 import logging
 import signal
 import time
@@ -6,6 +7,13 @@ from typing import Any, Awaitable, Callable, Coroutine, Dict, Optional
 
 import nats
 from nats.aio.client import Client
+
+try:
+    import uvloop
+
+    UVLOOP_AVAILABLE = True
+except ImportError:
+    UVLOOP_AVAILABLE = False
 from nats.aio.msg import Msg
 from nats.js import JetStreamContext
 from nats.js.kv import KeyValue
@@ -19,16 +27,121 @@ logging.basicConfig(
 )
 
 
+class Histogram:
+    """Log-bucketed latency histogram with fixed memory and O(1) recording.
+
+    Durations land in power-of-two microsecond buckets, so recording is an
+    int conversion plus a list increment and percentiles carry at most 2x
+    relative error — plenty for answering "where did the frame budget go"
+    without perturbing the hot path being measured.
+    """
+
+    BUCKETS = 64
+
+    def __init__(self):
+        self.counts = [0] * self.BUCKETS
+        self.count = 0
+        self.total = 0.0
+        self.max = 0.0
+
+    def record(self, seconds: float):
+        index = int(seconds * 1e6).bit_length()
+        if index >= self.BUCKETS:
+            index = self.BUCKETS - 1
+        self.counts[index] += 1
+        self.count += 1
+        self.total += seconds
+        if seconds > self.max:
+            self.max = seconds
+
+    def percentile(self, p: float) -> float:
+        """Upper bound of the bucket containing the p-th quantile, in seconds."""
+        threshold = self.count * p
+        seen = 0
+        for index, count in enumerate(self.counts):
+            seen += count
+            if seen >= threshold:
+                return (1 << index) / 1e6
+        return self.max
+
+    def reset(self):
+        self.counts = [0] * self.BUCKETS
+        self.count = 0
+        self.total = 0.0
+        self.max = 0.0
+
+
+class _Timer:
+    __slots__ = ("histogram", "started")
+
+    def __init__(self, histogram: Histogram):
+        self.histogram = histogram
+
+    def __enter__(self):
+        self.started = time.perf_counter()
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.histogram.record(time.perf_counter() - self.started)
+
+
 class RabbitNode:
+    # Heartbeat period on rabbit.node.<name>.ready once init() has completed
+    READY_INTERVAL = 1.0
+
     def __init__(self, name: str):
         self.name = name
         self.__nc: Optional[Client] = None
         self.__js: Optional[JetStreamContext] = None
         self.__kv: Optional[KeyValue] = None
+        self.__started = time.time()
         self.tasks: list[asyncio.Task] = []
         self.kv_watchers: list[KeyValue.KeyWatcher] = []
+        self.conflation_drops: Dict[str, int] = {}
+        self.timers: Dict[str, Histogram] = {}
         self.logger = logging.getLogger(name)
 
+    def timer(self, name: str) -> _Timer:
+        """Time a code section into a named histogram.
+
+        Usage: `with self.timer("encode"): ...`. Histograms are flushed to
+        telegraf via rabbit.metrics every 10 seconds (measurement "timings",
+        tagged with node and timer name). subscribe callbacks and set_interval
+        ticks are timed automatically.
+        """
+        histogram = self.timers.get(name)
+        if histogram is None:
+            histogram = self.timers[name] = Histogram()
+        return _Timer(histogram)
+
+    async def flush_timers(self):
+        metrics = []
+        timestamp = int(time.time() * 1000)
+
+        for name, histogram in self.timers.items():
+            if histogram.count == 0:
+                continue
+
+            metrics.append(
+                {
+                    "measurement": "timings",
+                    "tags": {"node": self.name, "timer": name},
+                    "fields": {
+                        "count": histogram.count,
+                        "mean_ms": histogram.total / histogram.count * 1000,
+                        "p50_ms": histogram.percentile(0.50) * 1000,
+                        "p95_ms": histogram.percentile(0.95) * 1000,
+                        "p99_ms": histogram.percentile(0.99) * 1000,
+                        "max_ms": histogram.max * 1000,
+                    },
+                    "timestamp": timestamp,
+                }
+            )
+            histogram.reset()
+
+        if metrics:
+            await self.nc.publish("rabbit.metrics", json.dumps(metrics).encode())
+
     async def watch_kv(
         self, key: str, fn: Callable[[KeyValue.Entry], Awaitable[None]]
     ) -> None:
@@ -72,15 +185,151 @@ class RabbitNode:
 
         self.tasks.append(asyncio.create_task(task()))
 
+    async def publish_sensor(
+        self, subject: str, payload: bytes, headers: Optional[Dict[str, str]] = None
+    ):
+        """Publish on the no-persistence fast path.
+
+        Plain core NATS, at-most-once, never captured by a JetStream stream
+        (see workspaces/nats): a slow consumer or a restart just misses frames,
+        and the broker never spends disk I/O on them. This is the default tier
+        for anything high-rate — frames, depth, poses, joystick commands.
+        """
+        await self.nc.publish(subject, payload, headers=headers)
+
+    async def publish_durable(
+        self, subject: str, payload: bytes, headers: Optional[Dict[str, str]] = None
+    ):
+        """Publish on the durable tier and wait for the stream acknowledgment.
+
+        The subject must be captured by a JetStream stream (created in
+        workspaces/nats/init.sh with tight age/size limits); use this for
+        low-rate data worth replaying after a crash, like power telemetry.
+        Config lives in the KV bucket and map data in the object store, which
+        are the other two durable-tier citizens.
+        """
+        await self.js.publish(subject, payload, headers=headers)
+
+    async def __publish_ready(self):
+        payload = json.dumps(
+            {"node": self.name, "uptime_s": round(time.time() - self.__started, 1)}
+        )
+        await self.nc.publish(f"rabbit.node.{self.name}.ready", payload.encode())
+
+    async def wait_for_node(self, name: str, timeout: Optional[float] = None):
+        """Block until the named node publishes a readiness heartbeat.
+
+        Every node heartbeats on rabbit.node.<name>.ready once its init()
+        has completed, so one received message is enough whether the
+        upstream started first or is still booting. Waiting here replaces
+        crash-looping through docker restarts when a dependency (like the
+        zed node's intrinsics) is not up yet; progress is logged with
+        exponential backoff while waiting.
+
+        Args:
+            name: Node name as passed to RabbitNode.__init__.
+            timeout: Give up and raise after this many seconds; None waits
+                forever.
+
+        Raises:
+            RuntimeError: If timeout elapses before a heartbeat arrives.
+        """
+        ready = asyncio.Event()
+
+        async def on_ready(msg: Msg):
+            ready.set()
+
+        sub = await self.nc.subscribe(f"rabbit.node.{name}.ready", cb=on_ready)
+        started = time.time()
+        delay = 1.0
+
+        try:
+            while not ready.is_set():
+                remaining = (
+                    None if timeout is None else timeout - (time.time() - started)
+                )
+                try:
+                    await asyncio.wait_for(
+                        ready.wait(), delay if remaining is None else min(delay, remaining)
+                    )
+                except asyncio.TimeoutError:
+                    waited = time.time() - started
+                    if timeout is not None and waited >= timeout:
+                        raise RuntimeError(
+                            f"Node {name} not ready after {waited:.0f}s"
+                        )
+                    self.logger.info(
+                        f"Waiting for node {name} to become ready ({waited:.0f}s)"
+                    )
+                    delay = min(delay * 2, 10)
+        finally:
+            await sub.unsubscribe()
+
+        self.logger.info(f"Node {name} is ready")
+
     async def subscribe(self, subject: str, cb: Callable[[Msg], Awaitable[None]]):
         async def safe_cb(msg: Msg):
             try:
-                await cb(msg)
+                with self.timer(f"sub.{subject}"):
+                    await cb(msg)
             except:
                 self.logger.exception(f"Error in subscriber for subject {subject}")
 
         await self.nc.subscribe(subject, cb=safe_cb)
 
+    async def subscribe_latest(self, subject: str, cb: Callable[[Msg], Awaitable[None]]):
+        """Subscribe conflating to the newest message on the subject.
+
+        While the callback is busy, newer messages replace the pending one and
+        intermediates are dropped, so a slow consumer always works on fresh
+        data instead of draining a stale queue. Drops are counted per subject
+        in self.conflation_drops and logged every 10 seconds.
+        """
+        pending: list = [None]
+        event = asyncio.Event()
+        self.conflation_drops.setdefault(subject, 0)
+
+        async def on_msg(msg: Msg):
+            if pending[0] is not None:
+                self.conflation_drops[subject] += 1
+            pending[0] = msg
+            event.set()
+
+        await self.nc.subscribe(subject, cb=on_msg)
+
+        async def worker():
+            reported = 0
+            last_report = time.time()
+
+            while True:
+                await event.wait()
+                event.clear()
+
+                msg = pending[0]
+                pending[0] = None
+                if msg is None:
+                    continue
+
+                try:
+                    with self.timer(f"sub.{subject}"):
+                        await cb(msg)
+                except:
+                    self.logger.exception(
+                        f"Error in subscriber for subject {subject}"
+                    )
+
+                now = time.time()
+                dropped = self.conflation_drops[subject]
+                if now - last_report > 10 and dropped > reported:
+                    self.logger.info(
+                        f"Conflated subject {subject}: dropped {dropped - reported} stale messages"
+                    )
+                    reported = dropped
+                    last_report = now
+
+        worker.__name__ = f"conflate:{subject}"
+        self.tasks.append(asyncio.create_task(worker()))
+
     @property
     def nc(self) -> Client:
         if self.__nc is None:
@@ -120,9 +369,12 @@ class RabbitNode:
         delay: float,
         max_parallel: Optional[int] = None,
     ) -> asyncio.Task[None]:
+        timer_name = f"interval.{getattr(callback, '__name__', 'tick')}"
+
         async def safe_callback():
             try:
-                await callback()
+                with self.timer(timer_name):
+                    await callback()
             except asyncio.CancelledError:
                 raise
             except Exception as e:
@@ -184,13 +436,22 @@ class RabbitNode:
         )
 
         self.__js = self.nc.jetstream()
-        self.__kv = await self.js.key_value("rabbit")
-        self.__object_store = await self.js.create_object_store("rabbit")
+        # Independent round trips to the broker; no reason to serialize them
+        self.__kv, self.__object_store = await asyncio.gather(
+            self.js.key_value("rabbit"),
+            self.js.create_object_store("rabbit"),
+        )
 
         self.logger.info(f"Node {self.name} initialized with NATS and JetStream")
         await self.init()
+        self.set_interval(self.flush_timers, 10)
+        self.set_interval(self.__publish_ready, self.READY_INTERVAL)
 
     def run_node(self):
+        if UVLOOP_AVAILABLE:
+            uvloop.install()
+            self.logger.info("Running on uvloop")
+
         async def main():
             loop = asyncio.get_running_loop()
             stop = asyncio.Event()
@@ -0,0 +1,100 @@
+from typing import Callable, Optional
+
+import numpy as np
+
+try:
+    import gi
+
+    gi.require_version("Gst", "1.0")
+    from gi.repository import Gst
+
+    Gst.init(None)
+    GSTREAMER_AVAILABLE = True
+except (ImportError, ValueError):
+    GSTREAMER_AVAILABLE = False
+
+
+class NvencEncoder:
+    """Hardware H.264/HEVC encoder backed by the Jetson NVENC block.
+
+    Frames are pushed as BGRA (the layout sl.Mat.get_data() returns for VIEW.LEFT)
+    and encoded elementary-stream chunks come back on the GStreamer streaming
+    thread via on_chunk(data, is_keyframe). The caller is responsible for hopping
+    back onto its own event loop before publishing.
+    """
+
+    def __init__(
+        self,
+        width: int,
+        height: int,
+        fps: int,
+        bitrate: int = 2_000_000,
+        codec: str = "h264",
+        on_chunk: Optional[Callable[[bytes, bool], None]] = None,
+    ):
+        if not GSTREAMER_AVAILABLE:
+            raise RuntimeError("GStreamer python bindings are not available")
+
+        if codec not in ("h264", "h265"):
+            raise ValueError(f"Unsupported codec: {codec}")
+
+        self.width = width
+        self.height = height
+        self.fps = fps
+        self.codec = codec
+        self.on_chunk = on_chunk
+        self._frame_duration = Gst.SECOND // fps
+        self._pts = 0
+
+        parse = "h264parse" if codec == "h264" else "h265parse"
+        pipeline = (
+            f"appsrc name=src is-live=true format=time "
+            f"caps=video/x-raw,format=BGRA,width={width},height={height},framerate={fps}/1 "
+            f"! nvvidconv ! video/x-raw(memory:NVMM),format=NV12 "
+            f"! nvv4l2{codec}enc bitrate={bitrate} insert-sps-pps=true "
+            f"iframeinterval={fps} maxperf-enable=true "
+            f"! {parse} config-interval=1 "
+            f"! appsink name=sink emit-signals=true sync=false max-buffers=2 drop=true"
+        )
+
+        self._pipeline = Gst.parse_launch(pipeline)
+        self._src = self._pipeline.get_by_name("src")
+        self._sink = self._pipeline.get_by_name("sink")
+        self._sink.connect("new-sample", self._on_sample)
+        self._pipeline.set_state(Gst.State.PLAYING)
+
+    def push_frame(self, frame: np.ndarray):
+        data = frame.tobytes()
+        buffer = Gst.Buffer.new_wrapped(data)
+        buffer.pts = self._pts
+        buffer.duration = self._frame_duration
+        self._pts += self._frame_duration
+
+        result = self._src.emit("push-buffer", buffer)
+        if result != Gst.FlowReturn.OK:
+            raise RuntimeError(f"Failed to push frame to encoder: {result}")
+
+    def _on_sample(self, sink) -> Gst.FlowReturn:
+        sample = sink.emit("pull-sample")
+        if sample is None:
+            return Gst.FlowReturn.ERROR
+
+        buffer = sample.get_buffer()
+        success, info = buffer.map(Gst.MapFlags.READ)
+        if not success:
+            return Gst.FlowReturn.ERROR
+
+        try:
+            data = bytes(info.data)
+        finally:
+            buffer.unmap(info)
+
+        is_keyframe = not buffer.has_flags(Gst.BufferFlags.DELTA_UNIT)
+        if self.on_chunk is not None:
+            self.on_chunk(data, is_keyframe)
+
+        return Gst.FlowReturn.OK
+
+    def close(self):
+        self._src.emit("end-of-stream")
+        self._pipeline.set_state(Gst.State.NULL)
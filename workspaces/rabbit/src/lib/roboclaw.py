@@ -1,11 +1,34 @@
 from datetime import datetime
+import asyncio
 import struct
 import threading
 import time
-from typing import Any, Dict, List, Optional, Tuple
+from collections import deque
+from typing import Any, Deque, Dict, List, Optional, Tuple
 
 import serial
 
+try:
+    from lib.crc16 import crc16 as _crc16_fn
+except ImportError:
+    # Table-driven fallback: still one lookup per byte instead of the original
+    # eight-iteration bit loop, just without leaving the interpreter.
+    _CRC16_TABLE = []
+    for _byte in range(256):
+        _crc = _byte << 8
+        for _ in range(8):
+            if _crc & 0x8000:
+                _crc = ((_crc << 1) ^ 0x1021) & 0xFFFF
+            else:
+                _crc = (_crc << 1) & 0xFFFF
+        _CRC16_TABLE.append(_crc)
+
+    def _crc16_fn(data: bytes) -> int:
+        crc = 0
+        for byte in data:
+            crc = ((crc << 8) ^ _CRC16_TABLE[((crc >> 8) ^ byte) & 0xFF]) & 0xFFFF
+        return crc
+
 
 class RoboClawDriver:
 
@@ -63,16 +86,7 @@ class RoboClawDriver:
         Returns:
             CRC16 checksum value.
         """
-        crc = 0
-        for byte in data:
-            crc = crc ^ (byte << 8)
-            for _ in range(8):
-                if crc & 0x8000:
-                    crc = ((crc << 1) ^ 0x1021) & 0xFFFF
-                else:
-                    crc = (crc << 1) & 0xFFFF
-
-        return crc
+        return _crc16_fn(bytes(data))
 
     def _get_response_crc(self, command: int, response: bytes) -> int:
         """Calculate CRC16 checksum for received data validation.
@@ -187,6 +201,107 @@ class RoboClawDriver:
 
         return response[:-2]
 
+    def _send_commands_pipelined(
+        self, commands: List[Tuple[int, bytes, int, str]]
+    ) -> List[bytes]:
+        """Send several commands back-to-back and read the responses in order.
+
+        RoboClaw processes packet serial commands sequentially, so instead of the
+        lock-step write/read round trip per command the whole batch is written to
+        the wire in a single write and the responses are drained afterwards. At
+        115200 baud this removes one serial turnaround per command.
+
+        Args:
+            commands: List of (command, args, read_bytes, kind) tuples where kind
+                is "ack" for 0xFF-acknowledged commands and "crc" for reads whose
+                response ends with a CRC16.
+
+        Returns:
+            List of response payloads (without CRC bytes) in command order; ack
+            commands yield empty bytes.
+
+        Raises:
+            RuntimeError: If the serial port is not open, a response is short,
+                an acknowledgment is invalid or a CRC check fails.
+        """
+        if not self._serial or not self._serial.is_open:
+            raise RuntimeError("Serial port not open")
+
+        with self._lock:
+            batch = bytearray()
+            for command, args, _, _ in commands:
+                packet = bytearray([self.address, command])
+                packet.extend(args)
+                packet.extend(struct.pack(">H", self._crc16(packet)))
+                batch.extend(packet)
+
+            self._serial.reset_input_buffer()
+            self._serial.write(batch)
+
+            results: List[bytes] = []
+            for command, _, read_bytes, kind in commands:
+                response = self._serial.read(read_bytes)
+                if len(response) != read_bytes:
+                    raise RuntimeError(
+                        f"Invalid response from command ({command}): expected {read_bytes}, got {len(response)}"
+                    )
+
+                if kind == "ack":
+                    if response[0] != 0xFF:
+                        raise RuntimeError(
+                            f"Invalid response: expected 0xFF, got {response[0]:02X}"
+                        )
+                    results.append(b"")
+                else:
+                    crc = self._unpack_u16(response[-2:])
+                    control_crc = self._get_response_crc(command, response)
+                    if crc != control_crc:
+                        raise RuntimeError(
+                            f"CRC mismatch: received {crc:04X}, expected {control_crc:04X}"
+                        )
+                    results.append(response[:-2])
+
+            return results
+
+    def drive_and_read_telemetry(
+        self, duty_m1: int, duty_m2: int
+    ) -> Dict[str, Any]:
+        """Drive both motors and read the per-tick telemetry in one wire batch.
+
+        Pipelines command 34 (Drive M1/M2 With Signed Duty Cycle) with the
+        telemetry reads issued on every control tick: encoders (16, 17), motor
+        currents (49) and main battery voltage (24).
+
+        Args:
+            duty_m1: M1 duty cycle value in range -32767 to +32767.
+            duty_m2: M2 duty cycle value in range -32767 to +32767.
+
+        Returns:
+            Dict with encoder_m1, encoder_m2 (count, status tuples),
+            motor_currents (amps tuple) and main_battery_voltage (volts).
+        """
+        responses = self._send_commands_pipelined(
+            [
+                (34, struct.pack(">hh", duty_m1, duty_m2), 1, "ack"),
+                (16, b"", 7, "crc"),
+                (17, b"", 7, "crc"),
+                (49, b"", 6, "crc"),
+                (24, b"", 4, "crc"),
+            ]
+        )
+
+        _, enc_m1, enc_m2, currents, battery = responses
+
+        return {
+            "encoder_m1": (self._unpack_i32(enc_m1[:4]), enc_m1[4]),
+            "encoder_m2": (self._unpack_i32(enc_m2[:4]), enc_m2[4]),
+            "motor_currents": (
+                self._unpack_i16(currents[:2]) / 100.0,
+                self._unpack_i16(currents[2:4]) / 100.0,
+            ),
+            "main_battery_voltage": self._unpack_u16(battery) / 10.0,
+        }
+
     def _unpack_u16(self, data: bytes) -> int:
         return struct.unpack(">H", data)[0]
 
@@ -2756,6 +2871,254 @@ class RoboClawDriver:
         return temp_raw / 10.0
 
 
+class RoboClawAsyncTransport:
+    """Asyncio serial transport for the RoboClaw packet serial protocol.
+
+    The blocking RoboClawDriver holds the event loop hostage for a full serial
+    round trip per command (up to the 0.1 s timeout when the controller
+    hiccups). This transport keeps the loop free: writes go through a command
+    queue drained by a writer task, responses arrive via a non-blocking fd
+    reader registered on the loop, and each submitted batch resolves a future
+    once its bytes have been received and validated. A batch that does not
+    complete within the timeout fails its future and resynchronizes the stream
+    by dropping buffered bytes and any batches queued behind it.
+    """
+
+    def __init__(
+        self,
+        port: str,
+        baudrate: int,
+        address: int,
+        timeout: float = 0.1,
+    ):
+        self.port = port
+        self.baudrate = baudrate
+        self.address = address
+        self.timeout = timeout
+        self._serial: Optional[serial.Serial] = None
+        self._queue: Optional[asyncio.Queue] = None
+        self._writer_task: Optional[asyncio.Task] = None
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._buffer = bytearray()
+        self._inflight: Deque[list] = deque()
+        self._write_lock = threading.Lock()
+        # Bytes the reader should swallow before resuming batch parsing —
+        # e.g. the ack of an emergency stop that lands after a stream reset
+        self._stray_bytes = 0
+
+    async def open(self):
+        """Open the serial port and start the reader/writer machinery."""
+        self._serial = serial.Serial(
+            port=self.port,
+            baudrate=self.baudrate,
+            timeout=0,
+            write_timeout=0,
+        )
+        await asyncio.sleep(0.1)
+
+        self._queue = asyncio.Queue()
+        self._loop = asyncio.get_running_loop()
+        self._loop.add_reader(self._serial.fileno(), self._on_readable)
+        self._writer_task = asyncio.create_task(self._writer())
+
+    async def close(self):
+        """Stop the writer task and close the serial port."""
+        if self._writer_task is not None:
+            self._writer_task.cancel()
+            try:
+                await self._writer_task
+            except asyncio.CancelledError:
+                pass
+            self._writer_task = None
+
+        if self._serial and self._serial.is_open:
+            asyncio.get_running_loop().remove_reader(self._serial.fileno())
+            self._serial.close()
+            self._serial = None
+
+    async def execute(self, commands: List[Tuple[int, bytes, int, str]]) -> List[bytes]:
+        """Submit a command batch and await its validated responses.
+
+        Args:
+            commands: List of (command, args, read_bytes, kind) tuples, same
+                shape as RoboClawDriver._send_commands_pipelined.
+
+        Returns:
+            List of response payloads (without CRC bytes) in command order; ack
+            commands yield empty bytes.
+
+        Raises:
+            RuntimeError: If the transport is not open, an acknowledgment is
+                invalid, a CRC check fails or the batch times out.
+        """
+        if self._queue is None:
+            raise RuntimeError("Serial transport not open")
+
+        future: asyncio.Future = asyncio.get_running_loop().create_future()
+        await self._queue.put((commands, future))
+        return await future
+
+    def _build_batch(self, commands: List[Tuple[int, bytes, int, str]]) -> bytes:
+        batch = bytearray()
+        for command, args, _, _ in commands:
+            packet = bytearray([self.address, command])
+            packet.extend(args)
+            packet.extend(struct.pack(">H", _crc16_fn(bytes(packet))))
+            batch.extend(packet)
+        return bytes(batch)
+
+    async def _writer(self):
+        loop = asyncio.get_running_loop()
+
+        while True:
+            commands, future = await self._queue.get()
+            if future.done():
+                continue
+
+            entry = [commands, future, None]
+            entry[2] = loop.call_later(self.timeout, self._on_timeout, entry)
+            self._inflight.append(entry)
+
+            try:
+                with self._write_lock:
+                    self._serial.write(self._build_batch(commands))
+            except Exception as e:
+                entry[2].cancel()
+                self._inflight.remove(entry)
+                future.set_exception(e)
+                continue
+
+            self._drain()
+
+    def _on_readable(self):
+        try:
+            chunk = self._serial.read(4096)
+        except Exception:
+            return
+
+        if chunk:
+            self._buffer.extend(chunk)
+            self._drain()
+
+    def _drain(self):
+        if self._stray_bytes:
+            drop = min(self._stray_bytes, len(self._buffer))
+            del self._buffer[:drop]
+            self._stray_bytes -= drop
+            if self._stray_bytes:
+                return
+
+        while self._inflight:
+            commands, future, handle = self._inflight[0]
+            if future.done():
+                self._inflight.popleft()
+                continue
+
+            expected = sum(read_bytes for _, _, read_bytes, _ in commands)
+            if len(self._buffer) < expected:
+                return
+
+            self._inflight.popleft()
+            handle.cancel()
+            raw = bytes(self._buffer[:expected])
+            del self._buffer[:expected]
+
+            try:
+                future.set_result(self._validate(commands, raw))
+            except RuntimeError as e:
+                future.set_exception(e)
+                # A failed ack or CRC check means the byte framing can no
+                # longer be trusted: a one-byte offset would otherwise pass
+                # exactly `expected` wrong bytes to every following batch
+                # forever without ever tripping the timeout. Drop what the OS
+                # still holds and fail the batches queued behind this one.
+                try:
+                    self._serial.reset_input_buffer()
+                except (OSError, serial.SerialException):
+                    pass
+                self._reset_stream("Serial stream reset after validation failure")
+                return
+
+    def _validate(
+        self, commands: List[Tuple[int, bytes, int, str]], raw: bytes
+    ) -> List[bytes]:
+        results: List[bytes] = []
+        offset = 0
+
+        for command, _, read_bytes, kind in commands:
+            response = raw[offset : offset + read_bytes]
+            offset += read_bytes
+
+            if kind == "ack":
+                if response[0] != 0xFF:
+                    raise RuntimeError(
+                        f"Invalid response: expected 0xFF, got {response[0]:02X}"
+                    )
+                results.append(b"")
+            else:
+                crc = struct.unpack(">H", response[-2:])[0]
+                validation_packet = bytearray([self.address, command])
+                validation_packet.extend(response[:-2])
+                control_crc = _crc16_fn(bytes(validation_packet))
+                if crc != control_crc:
+                    raise RuntimeError(
+                        f"CRC mismatch: received {crc:04X}, expected {control_crc:04X}"
+                    )
+                results.append(response[:-2])
+
+        return results
+
+    def emergency_stop(self):
+        """Write the duty-zero stop packet synchronously from any thread.
+
+        Safety path for the motor watchdog: it must not depend on event-loop
+        scheduling, so the packet goes out under the same lock the writer
+        task holds during batch writes — the stop is on the wire as soon as
+        the serial buffer drains, no matter what the loop is doing. The
+        stop's ack byte is a stray from the reader's point of view, so the
+        in-flight batches are failed, the stream is resynchronized through
+        the loop and the reader swallows the ack when it arrives — left
+        unconsumed it would offset every following batch by one byte; the
+        robot is stopping, losing a telemetry batch is fine.
+        """
+        if self._serial is None or not self._serial.is_open:
+            return
+
+        batch = self._build_batch([(34, struct.pack(">hh", 0, 0), 1, "ack")])
+        with self._write_lock:
+            self._serial.write(batch)
+
+        if self._loop is not None:
+            self._loop.call_soon_threadsafe(
+                self._reset_stream, "Serial stream reset by emergency stop", 1
+            )
+
+    def _reset_stream(self, reason: str, expect_stray: int = 0):
+        # Stream sync is lost: whatever partial bytes are buffered belong to
+        # a failed or interrupted batch, and any batch behind it would
+        # misparse them. expect_stray bytes still due on the wire (like the
+        # emergency stop's ack) are swallowed by _drain as they arrive.
+        self._buffer.clear()
+        self._stray_bytes += expect_stray
+        while self._inflight:
+            _, pending, handle = self._inflight.popleft()
+            handle.cancel()
+            if not pending.done():
+                pending.set_exception(RuntimeError(reason))
+
+    def _on_timeout(self, entry):
+        commands, future, _ = entry
+        if not future.done():
+            future.set_exception(
+                RuntimeError(
+                    f"Timed out waiting for response to commands "
+                    f"{[command for command, _, _, _ in commands]}"
+                )
+            )
+
+        self._reset_stream("Serial stream reset after command timeout")
+
+
 class RoboClaw:
     MAX_DUTY_CYCLE = 32767
     """Maximum duty cycle value for the motor, representing 100% speed."""
@@ -2867,6 +3230,160 @@ class RoboClaw:
         m2_speed = self._get_duty_cycle(m2_percent)
         self._driver.drive_m1_m2_with_signed_duty_cycle(m1_speed, m2_speed)
 
+    def move_with_telemetry(
+        self, m1_percent: float, m2_percent: float
+    ) -> Dict[str, Any]:
+        """Move both motors and read per-tick telemetry in one pipelined batch.
+
+        Args:
+            m1_percent: Motor 1 speed percentage (-1 to 1).
+            m2_percent: Motor 2 speed percentage (-1 to 1).
+
+        Returns:
+            Telemetry dict from RoboClawDriver.drive_and_read_telemetry.
+        """
+        m1_speed = self._get_duty_cycle(m1_percent)
+        m2_speed = self._get_duty_cycle(m2_percent)
+        return self._driver.drive_and_read_telemetry(m1_speed, m2_speed)
+
     def stop(self):
         """Stop both motors by setting duty cycle to 0."""
         self._driver.drive_m1_m2_with_signed_duty_cycle(0, 0)
+
+
+class AsyncRoboClaw:
+    """Non-blocking counterpart of RoboClaw for use inside async nodes.
+
+    Covers the hot-path commands issued from handlers and watchdogs; wire I/O
+    goes through RoboClawAsyncTransport so the event loop never waits on the
+    serial port.
+    """
+
+    MAX_DUTY_CYCLE = RoboClaw.MAX_DUTY_CYCLE
+    MIN_DUTY_CYCLE = RoboClaw.MIN_DUTY_CYCLE
+
+    def __init__(self, port: str, baudrate: int, address: int):
+        self._transport = RoboClawAsyncTransport(
+            port=port,
+            baudrate=baudrate,
+            address=address,
+        )
+
+    async def open(self):
+        await self._transport.open()
+        (response,) = await self._transport.execute([(21, b"", 29, "crc")])
+        version = response.split(b"\n", 1)[0].decode()
+        print(f"RoboClaw firmware version: {version}")
+
+    async def close(self):
+        await self._transport.close()
+
+    def _get_duty_cycle(self, percentage: float) -> int:
+        return int(
+            max(
+                self.MIN_DUTY_CYCLE,
+                min(self.MAX_DUTY_CYCLE, percentage * (self.MAX_DUTY_CYCLE / 1.0)),
+            )
+        )
+
+    async def move(self, m1_percent: float, m2_percent: float):
+        """Move both motors with specified duty cycle percentages.
+
+        Args:
+            m1_percent: Motor 1 speed percentage (-1 to 1).
+            m2_percent: Motor 2 speed percentage (-1 to 1).
+        """
+        m1_speed = self._get_duty_cycle(m1_percent)
+        m2_speed = self._get_duty_cycle(m2_percent)
+        await self._transport.execute(
+            [(34, struct.pack(">hh", m1_speed, m2_speed), 1, "ack")]
+        )
+
+    async def move_with_telemetry(
+        self, m1_percent: float, m2_percent: float
+    ) -> Dict[str, Any]:
+        """Move both motors and read per-tick telemetry in one pipelined batch.
+
+        Same wire batch as RoboClawDriver.drive_and_read_telemetry: command 34
+        plus encoders (16, 17), motor currents (49) and main battery
+        voltage (24).
+
+        Args:
+            m1_percent: Motor 1 speed percentage (-1 to 1).
+            m2_percent: Motor 2 speed percentage (-1 to 1).
+
+        Returns:
+            Dict with encoder_m1, encoder_m2 (count, status tuples),
+            motor_currents (amps tuple) and main_battery_voltage (volts).
+        """
+        m1_speed = self._get_duty_cycle(m1_percent)
+        m2_speed = self._get_duty_cycle(m2_percent)
+
+        responses = await self._transport.execute(
+            [
+                (34, struct.pack(">hh", m1_speed, m2_speed), 1, "ack"),
+                (16, b"", 7, "crc"),
+                (17, b"", 7, "crc"),
+                (49, b"", 6, "crc"),
+                (24, b"", 4, "crc"),
+            ]
+        )
+
+        _, enc_m1, enc_m2, currents, battery = responses
+
+        return {
+            "encoder_m1": (struct.unpack(">i", enc_m1[:4])[0], enc_m1[4]),
+            "encoder_m2": (struct.unpack(">i", enc_m2[:4])[0], enc_m2[4]),
+            "motor_currents": (
+                struct.unpack(">h", currents[:2])[0] / 100.0,
+                struct.unpack(">h", currents[2:4])[0] / 100.0,
+            ),
+            "main_battery_voltage": struct.unpack(">H", battery)[0] / 10.0,
+        }
+
+    async def read_odometry(self) -> Tuple[int, int, int, int]:
+        """Read both encoder counters and both instantaneous speeds.
+
+        Uses the combined commands 78 (Read Encoder Counters) and 79 (Read
+        Instantaneous Speeds), which return both motors per packet, so a full
+        odometry sample costs two pipelined packets on the wire instead of
+        four per-register round trips.
+
+        Returns:
+            Tuple of (encoder_m1, encoder_m2, speed_m1, speed_m2) with
+            encoder values in counts and speeds in counts per second.
+        """
+        counters, speeds = await self._transport.execute(
+            [(78, b"", 10, "crc"), (79, b"", 10, "crc")]
+        )
+        encoder_m1, encoder_m2 = struct.unpack(">ii", counters)
+        speed_m1, speed_m2 = struct.unpack(">ii", speeds)
+        return encoder_m1, encoder_m2, speed_m1, speed_m2
+
+    async def read_health(self) -> Dict[str, float]:
+        """Read motor currents, battery voltage and temperature in one batch.
+
+        The slow-changing health registers, for the once-a-second metrics
+        path; odometry has its own higher-rate batch in read_odometry.
+
+        Returns:
+            Dict with motor_current_m1/m2 (amps), main_battery_voltage
+            (volts) and temperature (degrees Celsius).
+        """
+        currents, battery, temperature = await self._transport.execute(
+            [(49, b"", 6, "crc"), (24, b"", 4, "crc"), (82, b"", 4, "crc")]
+        )
+        return {
+            "motor_current_m1": struct.unpack(">h", currents[:2])[0] / 100.0,
+            "motor_current_m2": struct.unpack(">h", currents[2:4])[0] / 100.0,
+            "main_battery_voltage": struct.unpack(">H", battery)[0] / 10.0,
+            "temperature": struct.unpack(">H", temperature)[0] / 10.0,
+        }
+
+    async def stop(self):
+        """Stop both motors by setting duty cycle to 0."""
+        await self._transport.execute([(34, struct.pack(">hh", 0, 0), 1, "ack")])
+
+    def emergency_stop(self):
+        """Synchronous stop for watchdog threads; see transport docs."""
+        self._transport.emergency_stop()
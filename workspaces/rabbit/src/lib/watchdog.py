@@ -0,0 +1,102 @@
+import logging
+import os
+import threading
+import time
+from typing import Callable
+
+
+class MotorWatchdog:
+    """Dead-man switch for motor outputs that does not trust the event loop.
+
+    The asyncio kill-switch interval stops the motors only as fast as the
+    loop schedules it — and loop latency degrades exactly when the node is
+    overloaded, which is when the stop matters most. This watchdog runs on
+    a dedicated daemon thread (elevated to SCHED_FIFO when the process has
+    the privilege) that polls a monotonic deadline every few milliseconds
+    and calls a synchronous stop function directly, so the worst-case stop
+    latency past the silence deadline is the poll interval plus the
+    hardware write — single-digit milliseconds regardless of what Python
+    code the loop is stuck in.
+
+    feed() is called from the command handler on every command; it is a
+    plain float store and safe to call from the loop thread. The stop
+    function runs on the watchdog thread and must be thread-safe with
+    respect to the normal command path.
+    """
+
+    def __init__(
+        self,
+        stop_fn: Callable[[], None],
+        timeout: float = 0.1,
+        poll_interval: float = 0.002,
+        priority: int = 50,
+        name: str = "motors",
+    ):
+        """Initialize the watchdog.
+
+        Args:
+            stop_fn: Synchronous function that forces the actuators to a
+                safe state. Invoked from the watchdog thread.
+            timeout: Command-stream silence threshold in seconds before
+                stop_fn fires. Defaults to 0.1.
+            poll_interval: Deadline check period in seconds; bounds the
+                stop latency past the deadline. Defaults to 0.002.
+            priority: SCHED_FIFO priority to request for the thread.
+                Defaults to 50.
+            name: Label used for the thread and logger names.
+        """
+        self.stop_fn = stop_fn
+        self.timeout = timeout
+        self.poll_interval = poll_interval
+        self.priority = priority
+        self.name = name
+        self.logger = logging.getLogger(f"watchdog.{name}")
+
+        self._last_fed = time.monotonic()
+        self._armed = False
+        self._shutdown = threading.Event()
+        self._thread: threading.Thread = None
+
+    def feed(self):
+        """Push the silence deadline out; arms the watchdog on first call."""
+        self._last_fed = time.monotonic()
+        self._armed = True
+
+    def start(self):
+        self._thread = threading.Thread(
+            target=self._run, name=f"watchdog-{self.name}", daemon=True
+        )
+        self._thread.start()
+
+    def stop(self):
+        self._shutdown.set()
+        if self._thread is not None:
+            self._thread.join(timeout=1)
+            self._thread = None
+
+    def _run(self):
+        try:
+            os.sched_setscheduler(
+                0, os.SCHED_FIFO, os.sched_param(self.priority)
+            )
+            self.logger.info(
+                f"Watchdog thread running with SCHED_FIFO priority {self.priority}"
+            )
+        except (OSError, AttributeError):
+            # Needs CAP_SYS_NICE; still beats the asyncio interval because
+            # the thread never waits behind loop callbacks
+            self.logger.warning(
+                "SCHED_FIFO unavailable, watchdog runs at normal priority"
+            )
+
+        while not self._shutdown.wait(self.poll_interval):
+            if self._armed and time.monotonic() - self._last_fed > self.timeout:
+                self._armed = False
+                try:
+                    self.stop_fn()
+                    self.logger.warning(
+                        f"Command stream silent for {self.timeout * 1000:.0f} ms, "
+                        f"actuators stopped"
+                    )
+                except Exception:
+                    self.logger.exception("Watchdog stop failed")
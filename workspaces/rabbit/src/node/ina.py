@@ -1,4 +1,7 @@
-import asyncio
+import json
+import struct
+import time
+from typing import Tuple
 
 from lib.node import RabbitNode
 from smbus2 import SMBus
@@ -26,53 +29,98 @@ def twos_complement(val: int, bits: int = 16) -> int:
 
 
 class Node(RabbitNode):
+    SAMPLE_RATE = 20
+
+    # One sample: timestamp ms (u64), vbus[4] and current[4] as f32
+    SAMPLE_STRUCT = struct.Struct("<Q8f")
+
+    # Batch header: magic, version, sample count
+    BATCH_HEADER = struct.Struct("<4sBxxxI")
+
     def __init__(self):
         super().__init__("ina4235")
         self.bus = SMBus(I2C_BUS)
+        self.pending: list = []
 
     async def init(self):
         self._write_calibration()
-        await self.async_task(self.publish_metrics)
+        self.set_interval(self.sample, 1 / self.SAMPLE_RATE)
+        self.set_interval(self.publish_telemetry, 1)
 
     def _write_calibration(self):
         shunt_cal = int(0.00512 / (CURRENT_LSB * R_SHUNT))
         cal_swapped = swap_bytes(shunt_cal)
         for reg in CALIB_REGS.values():
             self.bus.write_word_data(INA_ADDR, reg, cal_swapped)
-        print(f"Written SHUNT_CAL={shunt_cal} to calibration registers")
-
-    def _read_word(self, reg: int) -> int:
-        raw = self.bus.read_word_data(INA_ADDR, reg)
-        return swap_bytes(raw)
-
-    def read_bus_voltage(self, ch: int) -> float:
-        raw = self._read_word(BUS_VOLT_REGS[ch])
-        return raw * LSB_VBUS
-
-    def read_current(self, ch: int) -> float:
-        raw = self._read_word(CURRENT_REGS[ch])
-        signed = twos_complement(raw)
-        return signed * CURRENT_LSB
-
-    async def publish_metrics(self):
-        while True:
-            try:
-                for ch in range(1, 5):
-                    voltage = self.read_bus_voltage(ch)
-                    current = self.read_current(ch)
-                    power = voltage * current
-                    print(
-                        f"CH{ch}: VBUS = {voltage:.3f} V, I = {current:.3f} A, P = {power:.3f} W"
-                    )
-                print("-" * 50)
-            except Exception as e:
-                print(f"Error reading INA4235: {e}")
-            await asyncio.sleep(1)
+        self.logger.info(f"Written SHUNT_CAL={shunt_cal} to calibration registers")
+
+    def read_channel(self, ch: int) -> Tuple[float, float]:
+        """Read bus voltage and current for a channel in one block transaction.
+
+        VBUS and CURRENT are adjacent in the INA4235 register map, so a single
+        4-byte block read starting at the VBUS register replaces two word
+        transactions per channel.
+        """
+        block = self.bus.read_i2c_block_data(INA_ADDR, BUS_VOLT_REGS[ch], 4)
+        vbus_raw = (block[0] << 8) | block[1]
+        current_raw = (block[2] << 8) | block[3]
+
+        voltage = vbus_raw * LSB_VBUS
+        current = twos_complement(current_raw) * CURRENT_LSB
+        return voltage, current
+
+    async def sample(self):
+        timestamp = int(time.time() * 1000)
+        voltages = []
+        currents = []
+
+        for ch in range(1, 5):
+            voltage, current = self.read_channel(ch)
+            voltages.append(voltage)
+            currents.append(current)
+
+        self.pending.append((timestamp, *voltages, *currents))
+
+    async def publish_telemetry(self):
+        if not self.pending:
+            return
+
+        samples = self.pending
+        self.pending = []
+
+        # Packed batch for robot-side consumers
+        payload = bytearray(self.BATCH_HEADER.pack(b"PWRT", 1, len(samples)))
+        for entry in samples:
+            payload += self.SAMPLE_STRUCT.pack(*entry)
+
+        await self.publish_durable("rabbit.power.telemetry", bytes(payload))
+
+        # Telegraf ingests rabbit.metrics as JSON (see monitoring/telegraf.conf)
+        metrics = []
+        for entry in samples:
+            timestamp = entry[0]
+            for ch in range(4):
+                voltage = entry[1 + ch]
+                current = entry[5 + ch]
+                metrics.append(
+                    {
+                        "measurement": "power",
+                        "tags": {"node": "ina4235", "channel": str(ch + 1)},
+                        "fields": {
+                            "voltage": voltage,
+                            "current": current,
+                            "power": voltage * current,
+                        },
+                        "timestamp": timestamp,
+                    }
+                )
+
+        await self.nc.publish("rabbit.metrics", json.dumps(metrics).encode())
 
     async def close(self):
         await super().close()
         self.bus.close()
-        print("SMBus closed")
+        self.logger.info("SMBus closed")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,73 @@
+import json
+from typing import Dict
+
+from lib.node import Histogram, RabbitNode
+from nats.aio.msg import Msg
+
+# Pipeline stages as (name, start stamp, end stamp). Stamps are wall-clock
+# milliseconds appended by each stage: grab/encode/publish by the zed node,
+# receive/decode/render by the dashboard. The transport stage crosses from the
+# robot clock to the browser clock, so its absolute value includes clock skew;
+# its variance is still meaningful.
+STAGES = [
+    ("encode", "t_grab", "t_encode"),
+    ("publish", "t_encode", "t_publish"),
+    ("transport", "t_publish", "t_receive"),
+    ("decode", "t_receive", "t_decode"),
+    ("render", "t_decode", "t_render"),
+    ("end_to_end", "t_grab", "t_render"),
+]
+
+
+class Node(RabbitNode):
+    REPORT_INTERVAL = 5
+
+    def __init__(self):
+        super().__init__("latency")
+        self.report_histograms: Dict[str, Histogram] = {}
+        self.traces = 0
+
+    async def init(self):
+        await self.subscribe("rabbit.latency.trace", self.on_trace)
+        self.set_interval(self.publish_report, self.REPORT_INTERVAL)
+
+    async def on_trace(self, msg: Msg):
+        trace = json.loads(msg.data)
+        self.traces += 1
+
+        for name, start, end in STAGES:
+            if start not in trace or end not in trace:
+                continue
+
+            delta = (trace[end] - trace[start]) / 1000
+            if delta < 0:
+                continue
+
+            # Into the node's timer histograms for the telegraf flush, and
+            # into a separate set drained by the dashboard report
+            self.timers.setdefault(name, Histogram()).record(delta)
+            self.report_histograms.setdefault(name, Histogram()).record(delta)
+
+    async def publish_report(self):
+        report = {}
+        for name, histogram in self.report_histograms.items():
+            if histogram.count == 0:
+                continue
+
+            report[name] = {
+                "count": histogram.count,
+                "mean_ms": histogram.total / histogram.count * 1000,
+                "p50_ms": histogram.percentile(0.50) * 1000,
+                "p95_ms": histogram.percentile(0.95) * 1000,
+                "max_ms": histogram.max * 1000,
+            }
+            histogram.reset()
+
+        if report:
+            await self.nc.publish("rabbit.latency.report", json.dumps(report).encode())
+            self.logger.info(f"Published latency report from {self.traces} traces")
+            self.traces = 0
+
+
+if __name__ == "__main__":
+    Node().run_node()
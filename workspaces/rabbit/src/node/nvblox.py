@@ -1,16 +1,28 @@
+import asyncio
 import json
-from typing import Optional, List, Dict, Any
+import mmap
+import os
+import pickle
+import struct
+import time
+from typing import Optional, List, Dict, Any, Tuple
 
 import cv2
 import numpy as np
 import torch
-from lib.model import CameraIntrinsics, Pose
+from lib.cuda_ipc import import_cuda_tensor
+from lib.model import CameraIntrinsics, Pose, unpack_pose
 from lib.node import RabbitNode
 from nats.aio.msg import Msg
 from nats.js.kv import KeyValue
 from nvblox_torch.indexing import get_voxel_center_grids
-from nvblox_torch.mapper import Mapper
-from nvblox_torch.mapper_params import MapperParams, ProjectiveIntegratorParams
+from nvblox_torch.mapper import Mapper, QueryType
+from nvblox_torch.mapper_params import (
+    DecayIntegratorBaseParams,
+    MapperParams,
+    ProjectiveIntegratorParams,
+    TsdfDecayIntegratorParams,
+)
 from nvblox_torch.projective_integrator_types import ProjectiveIntegratorType
 
 
@@ -36,43 +48,166 @@ class Node(RabbitNode):
     # Constants
     MIN_DEPTH = 0.1
     MAX_DEPTH = 10.0
-    VOXEL_SIZE = 0.05
+    # Multi-resolution mapping: fine voxels near the camera, coarse beyond
+    VOXEL_SIZES = [0.05, 0.20]
+    NEAR_RANGE = 2.0
+    VOXEL_SIZE = VOXEL_SIZES[0]
     MAX_INTEGRATION_DISTANCE = 5.0
     SURFACE_THRESHOLD_MULTIPLIER = 2.0
     MIN_WEIGHT_THRESHOLD = 0.1
 
+    # magic, version, sequence, removed block count, changed block count, voxel size
+    DELTA_HEADER = struct.Struct("<4sBxxxIIIf")
+
+    # block index (3i) and mapper level, block voxel size, surface voxel count
+    BLOCK_HEADER = struct.Struct("<4ifI")
+
+    # removed block entry: block index (3i) and mapper level
+    REMOVED_BLOCK = struct.Struct("<4i")
+
+    # One full keyframe per minute at the 5 s delta cadence, for late joiners
+    KEYFRAME_INTERVAL = 12
+
+    # Upper bound on points per ESDF query batch; sizes the reused buffers
+    MAX_ESDF_QUERY_POINTS = 8192
+
+    # Frames kept per stream while waiting for their counterparts; at 30 Hz
+    # this absorbs ~250 ms of inter-stream jitter before frames are dropped
+    SYNC_BUFFER_FRAMES = 8
+
+    # Mirrors the stamp modulus in zed.py: the trailing element of each GPU
+    # depth slot carries frame_number % GPU_SLOT_STAMP_MOD
+    GPU_SLOT_STAMP_MOD = 1 << 24
+
+    # magic, version, sequence, vertex count, triangle count
+    MESH_HEADER = struct.Struct("<4sBxxxIII")
+
+    # Map snapshot on the /rabbit volume, so it survives container bounces
+    SNAPSHOT_PATH = "data/nvblox_snapshot.bin"
+    SNAPSHOT_SAVE_INTERVAL = 60
+
+    # magic, version, section count
+    SNAPSHOT_HEADER = struct.Struct("<4sBxxxI")
+
+    # layer kind (0=tsdf, 1=color), mapper level, voxel size, numpy dtype
+    # string, elements per voxel, block count
+    SNAPSHOT_SECTION = struct.Struct("<IIf4sII")
+
+    # Blocks copied to the host per chunk while writing a snapshot
+    SNAPSHOT_CHUNK_BLOCKS = 256
+
+    # Long-run memory bound: every DECAY_INTERVAL the TSDF decay integrator
+    # scales voxel weights by TSDF_DECAY_FACTOR and deallocates blocks whose
+    # weights have decayed to zero, so geometry the robot never revisits is
+    # evicted instead of accumulating until the Orin's shared memory starves
+    # the ZED SDK. Revisited geometry is re-integrated at full weight faster
+    # than it decays.
+    DECAY_INTERVAL = 10.0
+    TSDF_DECAY_FACTOR = 0.95
+    MEMORY_METRICS_INTERVAL = 10
+
+    # Viewport request: camera position (3f), column-major view-projection
+    # matrix (16f), block budget (u32); little-endian, mirrored by the
+    # viewport request in the web's PointCloud.tsx
+    VIEWPORT_STRUCT = struct.Struct("<3f16fI")
+
+    # Viewer-distance LOD: fine-mapper blocks beyond this range are sent
+    # subsampled at stride 2 — an eighth of the voxels at twice the size
+    VIEWPORT_LOD_RANGE = 6.0
+
     def __init__(self):
         super().__init__("nvblox")
 
         self.mapper: Optional[Mapper] = None
+        self.intrinsics: Optional[CameraIntrinsics] = None
         self.intrinsics_matrix: Optional[torch.Tensor] = None
-        self.latest_depth: Optional[np.ndarray] = None
-        self.latest_rgb: Optional[np.ndarray] = None
-        self.latest_pose: Optional[Pose] = None
+        self.depth_gpu_slots: Optional[list[torch.Tensor]] = None
         self.processing = False
 
+        # Synchronization stage: small per-stream ring buffers keyed by the
+        # zed node's frame_number; only matched bundles reach the integrator
+        self.depth_frames: Dict[int, Tuple[str, Any]] = {}
+        self.rgb_frames: Dict[int, np.ndarray] = {}
+        self.pose_frames: Dict[int, Pose] = {}
+        self.bundle: Optional[
+            Tuple[int, Tuple[str, Any, torch.Tensor], Optional[np.ndarray], Pose]
+        ] = None
+        self.sync_drops = 0
+        self.map_sequence = 0
+        self.block_signatures: Dict[Tuple[int, int, int, int], Tuple[float, float]] = {}
+
+        # Latest gathered surface, reused by viewport queries so a reply
+        # never pays a GPU gather of its own
+        self.surface_cache = None
+
+        # Stride-2 subsample pattern over a block's 8x8x8 voxel grid, the
+        # coarse LOD applied to distant blocks in viewport replies
+        stride = torch.zeros(8, dtype=torch.bool, device="cuda")
+        stride[::2] = True
+        self.lod_mask = (
+            stride[:, None, None] & stride[None, :, None] & stride[None, None, :]
+        )
+
+        # Reused ESDF query buffers: device-side query/output plus a pinned
+        # host staging tensor so the reply copy never pays a pageable transfer
+        self.esdf_query = torch.zeros(
+            (self.MAX_ESDF_QUERY_POINTS, 4), dtype=torch.float32, device="cuda"
+        )
+        self.esdf_out = torch.zeros(
+            (self.MAX_ESDF_QUERY_POINTS, 1), dtype=torch.float32, device="cuda"
+        )
+        self.esdf_out_pinned = torch.zeros(
+            (self.MAX_ESDF_QUERY_POINTS, 1), dtype=torch.float32, pin_memory=True
+        )
+
         projective_integrator_params = ProjectiveIntegratorParams()
         projective_integrator_params.projective_integrator_max_integration_distance_m = (
             self.MAX_INTEGRATION_DISTANCE
         )
 
+        decay_base_params = DecayIntegratorBaseParams()
+        decay_base_params.deallocate_decayed_blocks = True
+
+        tsdf_decay_params = TsdfDecayIntegratorParams()
+        tsdf_decay_params.tsdf_decay_factor = self.TSDF_DECAY_FACTOR
+
         mapper_params = MapperParams()
         mapper_params.set_projective_integrator_params(projective_integrator_params)
+        mapper_params.set_decay_integrator_base_params(decay_base_params)
+        mapper_params.set_tsdf_decay_integrator_params(tsdf_decay_params)
 
         self.mapper = Mapper(
-            voxel_sizes_m=self.VOXEL_SIZE,
-            integrator_types=ProjectiveIntegratorType.TSDF,
+            voxel_sizes_m=self.VOXEL_SIZES,
+            integrator_types=[ProjectiveIntegratorType.TSDF] * len(self.VOXEL_SIZES),
             mapper_parameters=mapper_params,
         )
 
     async def init(self):
+        # The zed node writes the intrinsics during its own init; wait for
+        # its readiness heartbeat instead of crashing on a missing KV entry
+        # and cycling through docker restarts
+        # The zed node registers as "rabbit-zed"; the timeout turns a wrong
+        # name or a dead camera into a loud RuntimeError (and a container
+        # restart) instead of blocking init forever
+        await self.wait_for_node("rabbit-zed", timeout=120)
         await self.load_camera_intrinsics()
-        await self.nc.subscribe("rabbit.zed.frame", cb=self.on_rgb_frame)
-        await self.nc.subscribe("rabbit.zed.depth", cb=self.on_depth_frame)
+        self.load_snapshot()
+        await self.subscribe_latest("rabbit.zed.frame", self.on_rgb_frame)
+        await self.subscribe_latest("rabbit.zed.depth", self.on_depth_frame)
+        await self.subscribe_latest("rabbit.zed.depth_gpu", self.on_depth_frame_gpu)
+        await self.nc.subscribe("rabbit.zed.pose_bin", cb=self.on_pose_frame)
         await self.watch_kv("rabbit.zed.pose", self.on_pose_update)
 
+        await self.subscribe("rabbit.nvblox.esdf.query", self.on_esdf_query)
+        await self.subscribe("rabbit.nvblox.viewport", self.on_viewport_query)
+
         self.set_interval(self.update_and_publish_map, 5)
+        self.set_interval(self.publish_mesh, 5)
         self.set_interval(self.process_frame, 0.1)
+        self.set_interval(self.update_esdf, 1)
+        self.set_interval(self.save_snapshot, self.SNAPSHOT_SAVE_INTERVAL)
+        self.set_interval(self.decay_map, self.DECAY_INTERVAL)
+        self.set_interval(self.publish_memory_metrics, self.MEMORY_METRICS_INTERVAL)
 
     async def load_camera_intrinsics(self):
         entry = await self.kv.get("rabbit.zed.intrinsics")
@@ -80,6 +215,7 @@ class Node(RabbitNode):
             raise KeyError("Camera intrinsics not found in KeyValue store")
 
         intrinsics = CameraIntrinsics.model_validate_json(entry.value)
+        self.intrinsics = intrinsics
         self.intrinsics_matrix = torch.tensor(
             [
                 [intrinsics.fx, 0, intrinsics.cx],
@@ -91,13 +227,88 @@ class Node(RabbitNode):
 
         self.logger.info(f"Loaded camera intrinsics: {intrinsics}")
 
+    def _depth_intrinsics(
+        self, full_w: int, full_h: int, roi_x: int = 0, roi_y: int = 0
+    ) -> torch.Tensor:
+        """Intrinsics matrix for a depth frame retrieved at full_w x full_h
+        and optionally ROI-cropped at (roi_x, roi_y).
+
+        The KV intrinsics describe the native camera resolution; the depth
+        stream is retrieved at a (reconfigurable) lower resolution and may be
+        cropped, so the focal lengths and principal point are scaled by the
+        retrieve resolution and the principal point shifted by the crop
+        origin. Integrating against the unadjusted full-frame matrix would
+        make any non-default setting geometrically wrong.
+        """
+        sx = full_w / self.intrinsics.width
+        sy = full_h / self.intrinsics.height
+        return torch.tensor(
+            [
+                [self.intrinsics.fx * sx, 0, self.intrinsics.cx * sx - roi_x],
+                [0, self.intrinsics.fy * sy, self.intrinsics.cy * sy - roi_y],
+                [0, 0, 1],
+            ],
+            dtype=torch.float32,
+        )
+
+    def _store_synced(self, buffer: Dict[int, Any], frame_number: int, value: Any):
+        """Store a frame in its ring buffer and try to assemble a bundle.
+
+        A bundle is the highest frame_number present in both the depth and
+        pose buffers. RGB is matched to the nearest buffered frame rather
+        than required: the JPEG stream is decimated to a few Hz while H.264
+        is active, and demanding an exact color match would cap depth
+        integration at that rate. A bundle with no usable RGB integrates
+        depth-only. Once matched, older entries are dropped — integrating a
+        frame behind one already handed to the mapper only smears the TSDF.
+        """
+        buffer[frame_number] = value
+        while len(buffer) > self.SYNC_BUFFER_FRAMES:
+            del buffer[min(buffer)]
+            self.sync_drops += 1
+
+        common = self.depth_frames.keys() & self.pose_frames.keys()
+        if not common:
+            return
+
+        frame = max(common)
+        rgb = self.rgb_frames.get(frame)
+        if rgb is None and self.rgb_frames:
+            nearest = min(self.rgb_frames, key=lambda number: abs(number - frame))
+            if abs(nearest - frame) <= self.SYNC_BUFFER_FRAMES:
+                rgb = self.rgb_frames[nearest]
+
+        self.bundle = (
+            frame,
+            self.depth_frames.pop(frame),
+            rgb,
+            self.pose_frames.pop(frame),
+        )
+
+        for stream in (self.depth_frames, self.pose_frames):
+            for stale in [number for number in stream if number < frame]:
+                del stream[stale]
+                self.sync_drops += 1
+        # The nearest RGB stays buffered to color the bundles between JPEG
+        # arrivals; the size cap above keeps the buffer bounded
+
     async def on_rgb_frame(self, msg: Msg):
+        headers = msg.headers or {}
+        frame_number = int(headers.get("frame_number", -1))
+        if frame_number < 0:
+            return
+
         nparr = np.frombuffer(msg.data, np.uint8)
         rgb_image = cv2.imdecode(nparr, cv2.IMREAD_COLOR)
-        self.latest_rgb = cv2.cvtColor(rgb_image, cv2.COLOR_BGR2RGB)
+        rgb_image = cv2.cvtColor(rgb_image, cv2.COLOR_BGR2RGB)
+        self._store_synced(self.rgb_frames, frame_number, rgb_image)
 
     async def on_depth_frame(self, msg: Msg):
         headers = msg.headers or {}
+        frame_number = int(headers.get("frame_number", -1))
+        if frame_number < 0:
+            return
+
         depth_scale = float(headers.get("depth_scale", 0.001))
         nparr = np.frombuffer(msg.data, np.uint8)
         depth_image = cv2.imdecode(nparr, cv2.IMREAD_UNCHANGED)
@@ -108,151 +319,745 @@ class Node(RabbitNode):
         valid_mask = (depth_image > self.MIN_DEPTH) & (depth_image < self.MAX_DEPTH)
         depth_image[~valid_mask] = 0.0
 
-        self.latest_depth = depth_image
+        intrinsics = self._depth_intrinsics(
+            int(headers.get("full_w", depth_image.shape[1])),
+            int(headers.get("full_h", depth_image.shape[0])),
+            int(headers.get("roi_x", 0)),
+            int(headers.get("roi_y", 0)),
+        )
+        self._store_synced(
+            self.depth_frames, frame_number, ("cpu", depth_image, intrinsics)
+        )
+
+    async def on_depth_frame_gpu(self, msg: Msg):
+        # Zero-copy path: the zed node keeps the sanitized depth frame in CUDA IPC
+        # slots and only notifies us which slot to read, so nothing crosses the CPU.
+        if self.depth_gpu_slots is None:
+            entry = await self.kv.get("rabbit.zed.depth_gpu_handles")
+            if entry.value is None:
+                raise KeyError("GPU depth IPC handles not found in KeyValue store")
+
+            self.depth_gpu_slots = [
+                import_cuda_tensor(handle) for handle in pickle.loads(entry.value)
+            ]
+            self.logger.info(
+                f"Mapped {len(self.depth_gpu_slots)} GPU depth IPC slots"
+            )
+
+        headers = msg.headers or {}
+        frame_number = int(headers.get("frame_number", -1))
+        if frame_number < 0:
+            return
+
+        # The zed node reuses its IPC slots every few frames, so the frame is
+        # cloned here to bind the content to its frame number. Each slot is a
+        # flat H*W+1 tensor whose trailing element is the producer's stamp;
+        # clone first, check the stamp second — if the producer has recycled
+        # the slot in between, the clone is of the wrong frame and is dropped.
+        slot = int(headers.get("slot", 0))
+        h = int(headers.get("h", 0))
+        w = int(headers.get("w", 0))
+        slot_tensor = self.depth_gpu_slots[slot]
+        if h * w + 1 != slot_tensor.numel():
+            self.logger.warning(
+                f"GPU depth slot {slot} has {slot_tensor.numel()} elements, expected {h}x{w}+1"
+            )
+            return
+
+        depth = slot_tensor[:-1].view(h, w).clone()
+        stamp = int(slot_tensor[-1].item())
+        if stamp != frame_number % self.GPU_SLOT_STAMP_MOD:
+            self.logger.warning(
+                f"Dropping stale GPU depth frame {frame_number}: slot {slot} restamped to {stamp}"
+            )
+            return
+
+        # IPC slots are full-frame at a fixed resolution (no ROI), so only
+        # the resolution scaling applies
+        self._store_synced(
+            self.depth_frames,
+            frame_number,
+            ("gpu", depth, self._depth_intrinsics(w, h)),
+        )
+
+    async def on_pose_frame(self, msg: Msg):
+        pose = unpack_pose(msg.data)
+        self._store_synced(self.pose_frames, pose.frame_number, pose)
 
     async def on_pose_update(self, entry: KeyValue.Entry):
         if entry.value:
-            self.latest_pose = Pose.model_validate_json(entry.value)
+            pose = Pose.model_validate_json(entry.value)
+            self._store_synced(self.pose_frames, pose.frame_number, pose)
+
+    async def update_esdf(self):
+        if self.mapper is not None:
+            self.mapper.update_esdf()
+
+    async def decay_map(self):
+        """Run one decay pass over all mappers.
+
+        Fully decayed blocks are deallocated by the C++ core, which the next
+        delta cycle observes as removed blocks — viewers clear them through
+        the normal delta path, no extra bookkeeping needed.
+        """
+        if self.mapper is None:
+            return
+
+        before = sum(
+            self.mapper.tsdf_layer_view(mapper_id=level).num_allocated_blocks()
+            for level in range(len(self.VOXEL_SIZES))
+        )
+        self.mapper.decay()
+        after = sum(
+            self.mapper.tsdf_layer_view(mapper_id=level).num_allocated_blocks()
+            for level in range(len(self.VOXEL_SIZES))
+        )
+
+        if after < before:
+            self.logger.info(f"Decay evicted {before - after} TSDF blocks")
+
+    async def publish_memory_metrics(self):
+        """Publish per-layer allocated blocks and bytes to telegraf."""
+        if self.mapper is None:
+            return
+
+        metrics = []
+        timestamp = int(time.time() * 1000)
+
+        layers = [
+            (f"tsdf.{level}", self.mapper.tsdf_layer_view(mapper_id=level))
+            for level in range(len(self.VOXEL_SIZES))
+        ]
+        layers.append(("color.0", self.mapper.color_layer_view(mapper_id=0)))
+
+        for name, layer in layers:
+            metrics.append(
+                {
+                    "measurement": "nvblox_memory",
+                    "tags": {"node": self.name, "layer": name},
+                    "fields": {
+                        "blocks": layer.num_allocated_blocks(),
+                        "bytes": layer.num_allocated_bytes(),
+                    },
+                    "timestamp": timestamp,
+                }
+            )
+
+        await self.nc.publish("rabbit.metrics", json.dumps(metrics).encode())
+
+    async def on_esdf_query(self, msg: Msg):
+        """Answer a batched ESDF distance query over request/reply.
+
+        The request payload is little-endian float32 points, Nx3 [x,y,z] or
+        Nx4 [x,y,z,radius] (dims header, default 3). The reply is float32
+        distances, one per point, computed against all mappers from the
+        preallocated device buffers and staged through pinned memory.
+        Malformed requests get an empty reply with an "error" header
+        instead of no reply at all, so callers fail fast rather than
+        sitting out their request timeout.
+        """
+        async def reply_error(error: str):
+            # A message published on the query subject without a reply inbox
+            # (not requested) has nowhere to send the error
+            if msg.reply:
+                await self.nc.publish(msg.reply, b"", headers={"error": error})
+
+        if self.mapper is None:
+            await reply_error("map not ready")
+            return
+
+        try:
+            headers = msg.headers or {}
+            dims = int(headers.get("dims", 3))
+            if dims not in (3, 4):
+                raise ValueError(f"Unsupported query dims: {dims}")
+
+            if len(msg.data) == 0 or len(msg.data) % (dims * 4) != 0:
+                raise ValueError(
+                    f"Payload of {len(msg.data)} bytes is not a multiple of {dims * 4}"
+                )
+
+            points = np.frombuffer(msg.data, np.float32).reshape(-1, dims)
+            n = len(points)
+            if n > self.MAX_ESDF_QUERY_POINTS:
+                raise ValueError(
+                    f"Query batch size {n} outside 1..{self.MAX_ESDF_QUERY_POINTS}"
+                )
+        except ValueError as e:
+            await reply_error(str(e))
+            return
+
+        query = self.esdf_query[:n]
+        query[:, :dims].copy_(torch.from_numpy(points.copy()))
+        if dims == 3:
+            query[:, 3].zero_()
+
+        out = self.esdf_out[:n]
+        self.mapper.query_layer(QueryType.ESDF, query, output=out)
+
+        pinned = self.esdf_out_pinned[:n]
+        pinned.copy_(out)
+
+        await msg.respond(pinned.numpy().tobytes())
 
     async def process_frame(self):
         if (
             self.processing
-            or self.latest_rgb is None
-            or self.latest_depth is None
-            or self.latest_pose is None
+            or self.bundle is None
             or self.mapper is None
             or self.intrinsics_matrix is None
         ):
             return
 
+        _, (depth_kind, depth, depth_intrinsics), rgb, pose = self.bundle
+        self.bundle = None
         self.processing = True
 
         # Convert pose to transformation matrix
         pose_matrix = pose_to_transformation_matrix(
-            self.latest_pose.translation, self.latest_pose.orientation
+            pose.translation, pose.orientation
         )
         pose_tensor = torch.from_numpy(pose_matrix).float()
 
-        # Convert images to tensors
-        depth_tensor = torch.from_numpy(self.latest_depth).float().cuda()
-        rgb_tensor = torch.from_numpy(self.latest_rgb).cuda()
-
-        # Add frames to mapper
-        self.mapper.add_depth_frame(depth_tensor, pose_tensor, self.intrinsics_matrix)
-        self.mapper.add_color_frame(rgb_tensor, pose_tensor, self.intrinsics_matrix)
+        # Convert images to tensors, preferring the GPU-resident IPC frame
+        if depth_kind == "gpu":
+            depth_tensor = depth
+            valid_mask = (depth_tensor > self.MIN_DEPTH) & (
+                depth_tensor < self.MAX_DEPTH
+            )
+            depth_tensor[~valid_mask] = 0.0
+        else:
+            depth_tensor = torch.from_numpy(depth).float().cuda()
 
-        # Clear processed data to free memory
-        self.latest_rgb = None
-        self.latest_depth = None
-        self.latest_pose = None
+        # Route depth by range: fine map gets geometry within NEAR_RANGE, the
+        # coarse map everything beyond, so distant geometry never pays the
+        # fine-voxel memory and integration cost
+        near_mask = depth_tensor <= self.NEAR_RANGE
+        # Depth uses the per-frame matrix carried with the bundle (scaled for
+        # the retrieve resolution and shifted for any ROI crop); color frames
+        # are full native resolution, so they keep the unadjusted matrix
+        self.mapper.add_depth_frame(
+            depth_tensor * near_mask, pose_tensor, depth_intrinsics, mapper_id=0
+        )
+        self.mapper.add_depth_frame(
+            depth_tensor * ~near_mask, pose_tensor, depth_intrinsics, mapper_id=1
+        )
+        # RGB is optional in a bundle (see _store_synced): geometry
+        # integrates at full depth rate, color at whatever rate JPEGs arrive
+        if rgb is not None:
+            rgb_tensor = torch.from_numpy(rgb).cuda()
+            self.mapper.add_color_frame(
+                rgb_tensor, pose_tensor, self.intrinsics_matrix, mapper_id=0
+            )
 
         self.processing = False
 
-    def extract_surface_voxels(self) -> List[Dict[str, Any]]:
-        """Extract voxels near the surface from TSDF."""
+    def _snapshot_layers(self):
+        """Layers included in a snapshot as (kind, level, layer) tuples.
+
+        TSDF for every mapper level; color only for the fine mapper, which is
+        the only one color frames are integrated into.
+        """
+        layers = [
+            (0, level, self.mapper.tsdf_layer_view(mapper_id=level))
+            for level in range(len(self.VOXEL_SIZES))
+        ]
+        layers.append((1, 0, self.mapper.color_layer_view(mapper_id=0)))
+        return layers
+
+    async def save_snapshot(self):
+        """Write the TSDF/color layers to the on-disk snapshot.
+
+        Layout: SNAPSHOT_HEADER, then per section SNAPSHOT_SECTION followed by
+        the block index table as int32[count, 3] and the raw voxel data of all
+        blocks back to back. Block data streams to the file in chunks straight
+        from the layer's block views, so host memory stays bounded regardless
+        of map size. The write goes to a temp file and replaces the snapshot
+        atomically.
+
+        Only the block gather runs on the event loop; the synchronizing
+        device-to-host copies and the file writes happen in a worker thread
+        so the sensor callbacks keep draining while a large map is written.
+        """
+        if self.mapper is None:
+            return
+
+        sections = [
+            (kind, level, layer.voxel_size(), *layer.get_all_blocks())
+            for kind, level, layer in self._snapshot_layers()
+        ]
+        await asyncio.to_thread(self._write_snapshot, sections)
+
+    def _write_snapshot(self, sections):
+        tmp_path = self.SNAPSHOT_PATH + ".tmp"
+        os.makedirs(os.path.dirname(self.SNAPSHOT_PATH), exist_ok=True)
+
+        total_blocks = 0
+        with open(tmp_path, "wb") as f:
+            f.write(self.SNAPSHOT_HEADER.pack(b"NVBS", 1, len(sections)))
+
+            for kind, level, voxel_size, blocks, indices in sections:
+                count = len(blocks)
+
+                if count == 0:
+                    f.write(
+                        self.SNAPSHOT_SECTION.pack(kind, level, voxel_size, b"f4", 0, 0)
+                    )
+                    continue
+
+                first = blocks[0].cpu().numpy()
+                elements = first.shape[-1]
+                dtype = first.dtype
+
+                f.write(
+                    self.SNAPSHOT_SECTION.pack(
+                        kind,
+                        level,
+                        voxel_size,
+                        dtype.str.lstrip("<>|").encode(),
+                        elements,
+                        count,
+                    )
+                )
+                # indices arrive as a list of per-block tensors
+                torch.stack(list(indices)).cpu().numpy().astype(np.int32).tofile(f)
+
+                for start in range(0, count, self.SNAPSHOT_CHUNK_BLOCKS):
+                    chunk = torch.stack(
+                        list(blocks[start : start + self.SNAPSHOT_CHUNK_BLOCKS])
+                    )
+                    chunk.cpu().numpy().tofile(f)
+
+                total_blocks += count
+
+        os.replace(tmp_path, self.SNAPSHOT_PATH)
+        self.logger.info(
+            f"Saved map snapshot: {total_blocks} blocks, "
+            f"{os.path.getsize(self.SNAPSHOT_PATH)} bytes"
+        )
+
+    def load_snapshot(self) -> bool:
+        """Restore the TSDF/color layers from the on-disk snapshot, if present.
+
+        The file is mmap-ed and block data is sliced out of the mapping with
+        numpy views; each block is allocated in the layer and filled through
+        its writable view, so restore cost is one block-sized host copy and
+        one H2D copy per block.
+        """
+        if not os.path.exists(self.SNAPSHOT_PATH):
+            return False
+
+        layers = {
+            (kind, level): layer for kind, level, layer in self._snapshot_layers()
+        }
+        restored = 0
+
+        with open(self.SNAPSHOT_PATH, "rb") as f, mmap.mmap(
+            f.fileno(), 0, access=mmap.ACCESS_READ
+        ) as mm:
+            magic, version, section_count = self.SNAPSHOT_HEADER.unpack_from(mm, 0)
+            if magic != b"NVBS":
+                self.logger.warning(f"Ignoring snapshot with bad magic: {magic}")
+                return False
+
+            offset = self.SNAPSHOT_HEADER.size
+            for _ in range(section_count):
+                kind, level, voxel_size, dtype_raw, elements, count = (
+                    self.SNAPSHOT_SECTION.unpack_from(mm, offset)
+                )
+                offset += self.SNAPSHOT_SECTION.size
+
+                if count == 0:
+                    continue
+
+                dtype = np.dtype(dtype_raw.rstrip(b"\x00").decode())
+                indices = np.frombuffer(mm, np.int32, count * 3, offset).reshape(
+                    count, 3
+                )
+                offset += count * 3 * 4
+
+                numel = count * 512 * elements
+                data = np.frombuffer(mm, dtype, numel, offset).reshape(count, -1)
+                offset += numel * dtype.itemsize
+
+                layer = layers.get((kind, level))
+                if layer is None or abs(layer.voxel_size() - voxel_size) > 1e-6:
+                    self.logger.warning(
+                        f"Skipping snapshot section (kind={kind}, level={level}, "
+                        f"voxel_size={voxel_size}): no matching layer"
+                    )
+                    continue
+
+                for i in range(count):
+                    index = torch.from_numpy(indices[i].copy())
+                    layer.allocate_block_at_index(index)
+                    view = layer.get_block_at_index(index)
+                    # Copy per block: the mmap views are read-only, which
+                    # torch.from_numpy warns about, and keeping the copies
+                    # block-sized bounds host memory on large maps
+                    view.copy_(torch.from_numpy(data[i].copy()).reshape(view.shape))
+                    restored += 1
+
+        self.logger.info(f"Restored {restored} blocks from map snapshot")
+        return restored > 0
+
+    def gather_surface_blocks(
+        self,
+    ) -> Optional[
+        Tuple[List[Tuple[int, int, int, int]], torch.Tensor, torch.Tensor, torch.Tensor, np.ndarray]
+    ]:
+        """Run one batched GPU pass over all TSDF blocks.
+
+        Stacks all blocks and voxel-center grids into single tensors and
+        computes the surface mask, the TSDF color gradient and a cheap
+        per-block content signature (tsdf sum, weight sum) used for delta
+        detection. No per-voxel Python objects are created anywhere.
+
+        Blocks from all mappers are merged into one set of stacks (a TSDF block
+        is 8x8x8 voxels regardless of voxel size, so the shapes line up); the
+        mapper level is part of each block's identity.
+
+        Returns:
+            Tuple of (block_indices, voxel_centers, surface_mask, colors,
+            signatures), where block_indices are (i, j, k, level) tuples, or
+            None when all maps are empty.
+        """
         if not self.mapper:
-            return []
+            return None
 
-        tsdf_layer = self.mapper.tsdf_layer_view()
-        blocks, indices = tsdf_layer.get_all_blocks()
+        block_indices: List[Tuple[int, int, int, int]] = []
+        center_stacks = []
+        mask_stacks = []
+        color_stacks = []
+        signature_stacks = []
 
-        if len(blocks) == 0:
-            return []
+        for level in range(len(self.VOXEL_SIZES)):
+            tsdf_layer = self.mapper.tsdf_layer_view(mapper_id=level)
+            blocks, indices = tsdf_layer.get_all_blocks()
 
-        voxel_size = tsdf_layer.voxel_size()
-        surface_threshold = self.SURFACE_THRESHOLD_MULTIPLIER * voxel_size
+            if len(blocks) == 0:
+                continue
 
-        voxel_centers_list = get_voxel_center_grids(indices, voxel_size, device="cuda")
+            voxel_size = tsdf_layer.voxel_size()
+            surface_threshold = self.SURFACE_THRESHOLD_MULTIPLIER * voxel_size
 
-        all_surface_centers = []
-        all_surface_tsdf = []
-        all_surface_weights = []
+            voxel_centers_list = get_voxel_center_grids(
+                indices, voxel_size, device="cuda"
+            )
 
-        # Batch process all blocks
-        for block, voxel_centers in zip(blocks, voxel_centers_list):
-            tsdf_values = block[..., 0]
-            weights = block[..., 1]
+            block_stack = torch.stack(list(blocks))
+            tsdf_values = block_stack[..., 0]
+            weights = block_stack[..., 1]
+            num_blocks = block_stack.shape[0]
 
-            # Find surface voxels
-            surface_mask = (torch.abs(tsdf_values) < surface_threshold) & (
-                weights > self.MIN_WEIGHT_THRESHOLD
+            mask_stacks.append(
+                (torch.abs(tsdf_values) < surface_threshold)
+                & (weights > self.MIN_WEIGHT_THRESHOLD)
             )
 
-            if torch.any(surface_mask):
-                all_surface_centers.append(voxel_centers[surface_mask])
-                all_surface_tsdf.append(tsdf_values[surface_mask])
-                all_surface_weights.append(weights[surface_mask])
-
-        if not all_surface_centers:
-            return []
-
-        # Concatenate and convert to CPU in batch
-        surface_centers = torch.cat(all_surface_centers).cpu().numpy()
-        surface_tsdf = torch.cat(all_surface_tsdf).cpu().numpy()
-        surface_weights = torch.cat(all_surface_weights).cpu().numpy()
-
-        # Create voxel data with gradient colors
-        voxel_data = []
-        for i in range(len(surface_centers)):
-            # Normalize TSDF for color gradient
-            normalized_tsdf = np.clip(surface_tsdf[i] / surface_threshold, -1, 1)
-
-            color = [
-                int(255 * max(0, normalized_tsdf)),  # Red for outside
-                int(128 * (1 - abs(normalized_tsdf))),  # Green at surface
-                int(255 * max(0, -normalized_tsdf)),  # Blue for inside
-            ]
+            # Color gradient: red outside, green at the surface, blue inside
+            normalized_tsdf = torch.clamp(tsdf_values / surface_threshold, -1.0, 1.0)
+            color_stacks.append(
+                torch.stack(
+                    [
+                        (255.0 * torch.clamp(normalized_tsdf, min=0.0)).to(torch.uint8),
+                        (128.0 * (1.0 - torch.abs(normalized_tsdf))).to(torch.uint8),
+                        (255.0 * torch.clamp(-normalized_tsdf, min=0.0)).to(torch.uint8),
+                    ],
+                    dim=-1,
+                )
+            )
 
-            voxel_data.append(
-                {
-                    "position": surface_centers[i].tolist(),
-                    "color": color,
-                    "tsdf": float(surface_tsdf[i]),
-                    "weight": float(surface_weights[i]),
-                }
+            signature_stacks.append(
+                torch.stack(
+                    [
+                        tsdf_values.reshape(num_blocks, -1).sum(dim=1),
+                        weights.reshape(num_blocks, -1).sum(dim=1),
+                    ],
+                    dim=1,
+                )
+            )
+
+            center_stacks.append(torch.stack(voxel_centers_list))
+            # get_all_blocks returns indices as a list of per-block tensors;
+            # stack them so the transfer to the host is a single copy
+            index_stack = torch.stack(list(indices)).cpu().numpy()
+            block_indices.extend(
+                (int(i), int(j), int(k), level) for i, j, k in index_stack
             )
 
-        return voxel_data
+        if not block_indices:
+            return None
+
+        centers_stack = torch.cat(center_stacks)
+        surface_mask = torch.cat(mask_stacks)
+        colors = torch.cat(color_stacks)
+        signatures = torch.cat(signature_stacks).cpu().numpy()
+
+        return block_indices, centers_stack, surface_mask, colors, signatures
+
+    def _pack_blocks(
+        self, surface, block_ids: List[int], coarse_ids: Optional[set] = None
+    ) -> bytes:
+        """Pack the given blocks as BLOCK_HEADER + float32 positions + uint8 colors.
+
+        Blocks in coarse_ids are subsampled at stride 2 and advertised at
+        twice their voxel size — the distance LOD for viewport replies.
+        """
+        block_indices, centers_stack, surface_mask, colors, _ = surface
+
+        if not block_ids:
+            return b""
+
+        # Gather every selected block on-GPU and cross to the host in one
+        # transfer per array; per-block .cpu() calls would synchronize the
+        # stream thousands of times per keyframe
+        ids = torch.tensor(block_ids, dtype=torch.long, device=surface_mask.device)
+        masks = surface_mask[ids]
+        if coarse_ids:
+            # Advanced indexing copied the rows, so the LOD cut can be
+            # applied in place without touching the cached surface
+            coarse_rows = [row for row, i in enumerate(block_ids) if i in coarse_ids]
+            if coarse_rows:
+                masks[coarse_rows] &= self.lod_mask
+
+        counts = masks.sum(dim=(1, 2, 3)).cpu().numpy()
+        positions = centers_stack[ids][masks].to(torch.float32).cpu().numpy()
+        voxel_colors = colors[ids][masks].cpu().numpy()
+
+        payload = bytearray()
+        offset = 0
+        for row, i in enumerate(block_ids):
+            level = block_indices[i][3]
+            voxel_size = self.VOXEL_SIZES[level]
+            if coarse_ids is not None and i in coarse_ids:
+                voxel_size *= 2
+
+            count = int(counts[row])
+            payload += self.BLOCK_HEADER.pack(*block_indices[i], voxel_size, count)
+            payload += positions[offset : offset + count].tobytes()
+            payload += voxel_colors[offset : offset + count].tobytes()
+            offset += count
 
-    async def publish_voxel_map(self, voxel_data: List[Dict[str, Any]]):
-        """Publish voxel map to object store."""
-        if not voxel_data:
+        return bytes(payload)
+
+    @staticmethod
+    def _frustum_planes(view_projection: np.ndarray) -> np.ndarray:
+        """Extract the six frustum planes from a view-projection matrix.
+
+        Standard Gribb-Hartmann extraction for the clip = M @ world
+        convention; planes are (a, b, c, d) rows with inward-pointing
+        normalized normals, so a point is inside when ax+by+cz+d > 0 for
+        all six.
+        """
+        rows = view_projection
+        planes = np.stack(
+            [
+                rows[3] + rows[0],
+                rows[3] - rows[0],
+                rows[3] + rows[1],
+                rows[3] - rows[1],
+                rows[3] + rows[2],
+                rows[3] - rows[2],
+            ]
+        )
+        return planes / np.linalg.norm(planes[:, :3], axis=1, keepdims=True)
+
+    async def on_viewport_query(self, msg: Msg):
+        """Answer a viewer's frustum with only the blocks it can see.
+
+        The request is VIEWPORT_STRUCT: camera position, the viewer's
+        view-projection matrix and a block budget. Blocks are culled against
+        the frustum (sphere test with the block's bounding radius), sorted
+        near-first, cut to the budget, and fine-mapper blocks beyond
+        VIEWPORT_LOD_RANGE are subsampled to coarse LOD. The reply is a
+        keyframe-shaped VOXD payload sliced from the latest gathered
+        surface, so answering costs no GPU pass and the viewer's existing
+        decoder applies it as a full refresh of what is on screen.
+        """
+        surface = self.surface_cache
+        if surface is None or len(msg.data) != self.VIEWPORT_STRUCT.size:
+            await msg.respond(b"")
             return
 
-        # Calculate bounds efficiently
-        positions = np.array([v["position"] for v in voxel_data])
-        bounds_min = positions.min(axis=0).tolist()
-        bounds_max = positions.max(axis=0).tolist()
-
-        voxel_output = {
-            "voxels": voxel_data,
-            "voxel_size": float(self.VOXEL_SIZE),
-            "num_voxels": len(voxel_data),
-            "bounds": {
-                "min": bounds_min,
-                "max": bounds_max,
-            },
+        fields = self.VIEWPORT_STRUCT.unpack(msg.data)
+        camera = np.array(fields[0:3], np.float32)
+        # THREE.js matrices arrive column-major
+        view_projection = np.array(fields[3:19], np.float32).reshape(4, 4, order="F")
+        budget = fields[19]
+
+        block_indices = surface[0]
+        indices = np.array([idx[:3] for idx in block_indices], np.float32)
+        levels = np.array([idx[3] for idx in block_indices])
+        block_sizes = np.array(self.VOXEL_SIZES, np.float32)[levels] * 8
+        centers = (indices + 0.5) * block_sizes[:, None]
+        radii = block_sizes * (np.sqrt(3.0) / 2)
+
+        planes = self._frustum_planes(view_projection)
+        plane_distances = centers @ planes[:, :3].T + planes[:, 3]
+        visible = np.flatnonzero((plane_distances > -radii[:, None]).all(axis=1))
+
+        camera_distances = np.linalg.norm(centers[visible] - camera, axis=1)
+        order = np.argsort(camera_distances)
+        selected = visible[order][: int(budget)]
+        selected_distances = camera_distances[order][: int(budget)]
+
+        coarse_ids = {
+            int(i)
+            for i, distance in zip(selected, selected_distances)
+            if distance > self.VIEWPORT_LOD_RANGE and levels[i] == 0
         }
 
+        header = self.DELTA_HEADER.pack(
+            b"VOXD",
+            1,
+            self.map_sequence,
+            0,
+            len(selected),
+            float(self.VOXEL_SIZE),
+        )
+        payload = self._pack_blocks(
+            surface, [int(i) for i in selected], coarse_ids=coarse_ids
+        )
+        await msg.respond(header + payload)
+
+    async def publish_keyframe(self, surface) -> None:
+        """Publish the full map to the object store as an all-blocks delta.
+
+        Keyframes use the same block-structured DELTA_HEADER format as the
+        incremental messages (removed count 0, every block listed as changed),
+        so late joiners load the keyframe, reset their block table and then
+        apply deltas with a higher sequence number.
+        """
+        block_indices = surface[0]
+
+        header = self.DELTA_HEADER.pack(
+            b"VOXD",
+            1,
+            self.map_sequence,
+            0,
+            len(block_indices),
+            float(self.VOXEL_SIZE),
+        )
+
+        payload = self._pack_blocks(surface, list(range(len(block_indices))))
+        await self.object_store.put("rabbit.nvblox.voxels", header + payload)
+
+        self.logger.info(
+            f"Published keyframe {self.map_sequence} with {len(block_indices)} blocks "
+            f"({len(header) + len(payload)} bytes)"
+        )
+
+    async def publish_map_delta(self, surface) -> None:
+        """Publish only the blocks that changed since the previous cycle.
+
+        Layout: DELTA_HEADER followed by removed block indices as int32[3]
+        each, then per changed block a BLOCK_HEADER with the block index and
+        surface voxel count, positions as float32 and colors as uint8. A
+        changed block with zero surface voxels tells the viewer to clear it.
+        """
+        block_indices, centers_stack, surface_mask, colors, signatures = surface
+
+        current: Dict[Tuple[int, int, int, int], Tuple[float, float]] = {}
+        changed: List[int] = []
+        for i, idx in enumerate(block_indices):
+            signature = (float(signatures[i][0]), float(signatures[i][1]))
+            current[idx] = signature
+            if self.block_signatures.get(idx) != signature:
+                changed.append(i)
+
+        removed = [idx for idx in self.block_signatures if idx not in current]
+        self.block_signatures = current
+
+        if not changed and not removed:
+            return
+
+        payload = bytearray(
+            self.DELTA_HEADER.pack(
+                b"VOXD",
+                1,
+                self.map_sequence,
+                len(removed),
+                len(changed),
+                float(self.VOXEL_SIZE),
+            )
+        )
+
+        for idx in removed:
+            payload += self.REMOVED_BLOCK.pack(*idx)
+
+        payload += self._pack_blocks(surface, changed)
+
+        await self.nc.publish("rabbit.nvblox.voxels.delta", bytes(payload))
+
+        self.logger.info(
+            f"Published map delta {self.map_sequence}: "
+            f"{len(changed)} changed, {len(removed)} removed blocks ({len(payload)} bytes)"
+        )
+
+    async def publish_mesh(self):
+        """Publish the fine-mapper color mesh as a packed binary object.
+
+        Layout: MESH_HEADER (magic, version, sequence, vertex count, triangle
+        count) followed by vertices as float32[V * 3], vertex colors as
+        uint8[V * 3] and triangle indices as uint32[T * 3]. Triangle data for
+        a room is a fraction of the equivalent voxel payload and renders
+        natively in THREE.js; the object store chunks the transfer.
+        """
+        if self.mapper is None:
+            return
+
+        self.mapper.update_color_mesh(mapper_id=0)
+        mesh = self.mapper.get_color_mesh(mapper_id=0)
+
+        vertices = mesh.vertices().cpu().numpy().astype(np.float32)
+        if len(vertices) == 0:
+            return
+
+        colors = mesh.vertex_colors().cpu().numpy().astype(np.uint8)
+        triangles = mesh.triangles().cpu().numpy().astype(np.uint32)
+
+        header = self.MESH_HEADER.pack(
+            b"MESH",
+            1,
+            self.map_sequence,
+            len(vertices),
+            len(triangles),
+        )
+
         await self.object_store.put(
-            "rabbit.nvblox.voxels", json.dumps(voxel_output).encode()
+            "rabbit.nvblox.mesh",
+            header + vertices.tobytes() + colors.tobytes() + triangles.tobytes(),
         )
 
         self.logger.info(
-            f"Published {len(voxel_data)} voxels, "
-            f"bounds: [{bounds_min[0]:.2f}, {bounds_min[1]:.2f}, {bounds_min[2]:.2f}] "
-            f"to [{bounds_max[0]:.2f}, {bounds_max[1]:.2f}, {bounds_max[2]:.2f}]"
+            f"Published mesh with {len(vertices)} vertices, {len(triangles)} triangles"
         )
 
     async def update_and_publish_map(self):
         """Main update cycle for map processing."""
-        surface_voxels = self.extract_surface_voxels()
+        if self.sync_drops:
+            self.logger.info(
+                f"Sync stage dropped {self.sync_drops} unmatched frames"
+            )
+            self.sync_drops = 0
 
-        if not surface_voxels:
+        surface = self.gather_surface_blocks()
+
+        if surface is None:
             self.logger.warning("No surface voxels found")
             return
 
-        await self.publish_voxel_map(surface_voxels)
+        self.surface_cache = surface
+        self.map_sequence += 1
+        await self.publish_map_delta(surface)
+
+        if self.map_sequence % self.KEYFRAME_INTERVAL == 1:
+            await self.publish_keyframe(surface)
+
+    async def close(self):
+        await super().close()
+        await self.save_snapshot()
 
 
 if __name__ == "__main__":
@@ -1,43 +1,89 @@
-import asyncio
 import json
 import time
 from typing import Optional
 
+from lib.model import Odometry, pack_odom, unpack_joy
 from lib.node import RabbitNode
-from lib.roboclaw import RoboClaw
+from lib.roboclaw import AsyncRoboClaw
+from lib.watchdog import MotorWatchdog
 from nats.aio.msg import Msg
 
 
 class Node(RabbitNode):
-    rc = RoboClaw(port="/dev/ttyTHS1", baudrate=115200, address=0x80)
+    ODOM_INTERVAL = 0.02  # 50 Hz wheel odometry
+    METRICS_INTERVAL = 1.0
 
     def __init__(self):
         super().__init__("roboclaw")
-        self.last_command_at: Optional[float] = None
+        self.rc = AsyncRoboClaw(port="/dev/ttyTHS1", baudrate=115200, address=0x80)
+        # Hardware-independent dead-man switch: a dedicated thread writes the
+        # stop packet directly if the joystick stream goes silent, so stop
+        # latency does not depend on event-loop health
+        self.watchdog = MotorWatchdog(
+            self.rc.emergency_stop, timeout=0.1, name="roboclaw"
+        )
+        # Latest odometry sample; a single reference store, so any coroutine
+        # can read it without locking
+        self.odom: Optional[Odometry] = None
 
     async def init(self):
-        self.rc.open()
+        await self.rc.open()
+        self.watchdog.start()
         await self.subscribe("rabbit.cmd.joy", self.joy_handler)
-        await self.async_task(self.publish_metrics)
-        await self.set_interval(self.kill_switch, 0.1)
+        self.set_interval(self.publish_odometry, self.ODOM_INTERVAL, max_parallel=1)
+        self.set_interval(self.publish_metrics, self.METRICS_INTERVAL, max_parallel=1)
 
-    async def kill_switch(self):
-        if self.last_command_at and time.time() - self.last_command_at > 0.1:
-            self.rc.move(0, 0)
-            self.last_command_at = None
+    async def publish_odometry(self):
+        """Sample both encoders and speeds, publish on the sensor fast path.
+
+        The combined reads (commands 78/79) make a full sample two packets on
+        the wire, cheap enough to interleave with drive commands at 50 Hz.
+        """
+        encoder_m1, encoder_m2, speed_m1, speed_m2 = await self.rc.read_odometry()
+        self.odom = Odometry(
+            encoder_m1=encoder_m1,
+            encoder_m2=encoder_m2,
+            speed_m1=speed_m1,
+            speed_m2=speed_m2,
+            timestamp=time.time_ns(),
+        )
+        await self.publish_sensor("rabbit.drive.odom", pack_odom(self.odom))
 
     async def publish_metrics(self):
-        await asyncio.sleep(1)
+        health = await self.rc.read_health()
+        timestamp = int(time.time() * 1000)
+
+        metrics = [
+            {
+                "measurement": name,
+                "tags": {"node": self.name},
+                "fields": {"value": value},
+                "timestamp": timestamp,
+            }
+            for name, value in health.items()
+        ]
+
+        if self.odom is not None:
+            metrics.append(
+                {
+                    "measurement": "wheel_speeds",
+                    "tags": {"node": self.name},
+                    "fields": {
+                        "speed_m1": self.odom.speed_m1,
+                        "speed_m2": self.odom.speed_m2,
+                    },
+                    "timestamp": timestamp,
+                }
+            )
+
+        await self.nc.publish("rabbit.metrics", json.dumps(metrics).encode())
 
     async def joy_handler(self, msg: Msg):
-        data = msg.data.decode()
-        json_data = json.loads(data)
-        r2 = json_data.get("buttons", {}).get("r2", {}).get("value", 0)
-        l2 = json_data.get("buttons", {}).get("l2", {}).get("value", 0)
-        speed = r2 - l2
+        self.watchdog.feed()
 
-        left_stick_x = json_data.get("sticks", {}).get("left", {}).get("x", 0)
-        angle = max(min(left_stick_x, 1), -1)
+        joy = unpack_joy(msg.data)
+        speed = joy.r2 - joy.l2
+        angle = max(min(joy.left_x, 1), -1)
 
         turn_factor = 0.6
         left_speed = speed
@@ -48,7 +94,13 @@ class Node(RabbitNode):
         elif angle > 0:
             right_speed = speed * (1 - angle * turn_factor)
 
-        self.rc.move(left_speed, right_speed)
+        await self.rc.move(left_speed, right_speed)
+
+    async def close(self):
+        await super().close()
+        self.watchdog.stop()
+        self.rc.emergency_stop()
+        await self.rc.close()
 
 
 if __name__ == "__main__":
@@ -1,11 +1,9 @@
-import json
-import time
-from typing import Optional
-
 import board
 import busio
 from adafruit_pca9685 import PCA9685
+from lib.model import unpack_joy
 from lib.node import RabbitNode
+from lib.watchdog import MotorWatchdog
 from nats.aio.msg import Msg
 
 
@@ -20,16 +18,20 @@ class Node(RabbitNode):
         self.pca = PCA9685(i2c, address=0x40)
         self.pca.frequency = 50
         self.channel = 0
-        self.last_command_at: Optional[float] = None
+        # The I2C write is safe from the watchdog thread: the adafruit
+        # driver locks the bus per transaction
+        self.watchdog = MotorWatchdog(
+            lambda: self.set_angle(0.5), timeout=0.1, name="steering"
+        )
 
     async def init(self):
+        self.watchdog.start()
         await self.subscribe("rabbit.cmd.joy", self.joy_handler)
-        await self.set_interval(self.kill_switch, 0.1)
 
-    async def kill_switch(self):
-        if self.last_command_at and time.time() - self.last_command_at > 0.1:
-            self.set_angle(0.5)
-            self.last_command_at = None
+    async def close(self):
+        await super().close()
+        self.watchdog.stop()
+        self.set_angle(0.5)
 
     def map_angle(self, angle):
         if angle < 0:
@@ -38,12 +40,10 @@ class Node(RabbitNode):
             return self.MID_PULSE + angle * (self.MAX_PULSE - self.MID_PULSE)
 
     async def joy_handler(self, msg: Msg):
-        self.last_command_at = time.time()
+        self.watchdog.feed()
 
-        data = msg.data.decode()
-        json_data = json.loads(data)
-        left_stick_x = json_data.get("sticks", {}).get("left", {}).get("x", 0)
-        angle = max(min(left_stick_x, 1), -1)
+        joy = unpack_joy(msg.data)
+        angle = max(min(joy.left_x, 1), -1)
         self.set_angle(angle)
 
     def set_angle(self, angle: float):
@@ -1,17 +1,34 @@
 import asyncio
+import pickle
+import time
 from concurrent.futures import ThreadPoolExecutor
 from typing import Optional
 
 import cv2
 import lz4.frame
 import numpy as np
-from lib.model import CameraIntrinsics, Pose
+from lib.model import CameraIntrinsics, Pose, pack_pose
 from lib.node import RabbitNode
+from lib.nvenc import GSTREAMER_AVAILABLE, NvencEncoder
 from nats.js.errors import KeyNotFoundError
 from nats.js.kv import KeyValue
 from pydantic import BaseModel, Field
 from pyzed import sl
 
+try:
+    from lib import depth_pack
+except ImportError:
+    depth_pack = None
+
+try:
+    import torch
+
+    from lib.cuda_ipc import export_cuda_tensor
+
+    TORCH_AVAILABLE = True
+except ImportError:
+    TORCH_AVAILABLE = False
+
 
 class CameraSettings(BaseModel):
     BRIGHTNESS: int = Field(default=4, ge=0, le=8)
@@ -26,16 +43,63 @@ class CameraSettings(BaseModel):
     WHITEBALANCE_AUTO: int = Field(default=1, ge=0, le=1)
 
 
+class DepthStreamSettings(BaseModel):
+    """Consumer-controllable depth stream shape, stored under DEPTH_STREAM_KEY.
+
+    roi_width/roi_height of 0 mean full frame. Rates are upper bounds: the
+    motion gate drops the stream to idle_rate_hz while the robot is
+    stationary, since identical depth at full rate is pure redundancy.
+    """
+
+    width: int = Field(default=640, ge=64, le=1280)
+    height: int = Field(default=480, ge=64, le=720)
+    rate_hz: float = Field(default=30.0, gt=0, le=30)
+    idle_rate_hz: float = Field(default=2.0, gt=0, le=30)
+    roi_x: int = Field(default=0, ge=0)
+    roi_y: int = Field(default=0, ge=0)
+    roi_width: int = Field(default=0, ge=0)
+    roi_height: int = Field(default=0, ge=0)
+
+
 class Node(RabbitNode):
     CAMERA_SETTINGS_KEY = "rabbit.zed.camera_settings"
+    DEPTH_GPU_HANDLES_KEY = "rabbit.zed.depth_gpu_handles"
+    # Reuse distance of the IPC slot ring: at 30 Hz, 4 slots give a consumer
+    # ~133 ms to clone a published frame before the producer recycles it
+    DEPTH_GPU_SLOTS = 4
+    # Each slot's trailing stamp element holds frame_number modulo this;
+    # float32 represents integers below 2^24 exactly
+    GPU_SLOT_STAMP_MOD = 1 << 24
+    DEPTH_WIDTH = 640
+    DEPTH_HEIGHT = 480
+    MAX_DEPTH_M = 16.0
+    DEPTH_STREAM_KEY = "rabbit.zed.depth_stream"
+
+    # Pose deltas below these thresholds count as stationary; the depth
+    # stream falls back to idle_rate_hz after STATIONARY_AFTER_S without motion
+    STATIONARY_TRANSLATION_M = 0.005
+    STATIONARY_ROTATION = 0.002
+    STATIONARY_AFTER_S = 1.0
+
+    # JPEG publish rate on rabbit.zed.frame while NVENC is carrying the
+    # primary video stream; viewers without WebCodecs decode this instead
+    JPEG_FALLBACK_RATE_HZ = 5
 
     def __init__(self):
         super().__init__("rabbit-zed")
 
         self.image = sl.Mat()
+        self.image_bgra: Optional[np.ndarray] = None
         self.depth = sl.Mat()
+        self.depth_f32 = np.empty((self.DEPTH_HEIGHT, self.DEPTH_WIDTH), np.float32)
+        self.depth_u16 = np.empty((self.DEPTH_HEIGHT, self.DEPTH_WIDTH), np.uint16)
+        self.depth_gpu = sl.Mat()
+        self.depth_gpu_slots: Optional[list] = None
+        self.depth_gpu_slot = 0
         self.zed = sl.Camera()
         self.pose = sl.Pose()
+        self.video_encoder: Optional[NvencEncoder] = None
+        self.loop: Optional[asyncio.AbstractEventLoop] = None
 
         self.runtime_params = sl.RuntimeParameters()
         self.camera_parameters = sl.CameraParameters()
@@ -54,6 +118,12 @@ class Node(RabbitNode):
         self.positional_tracking_parameters.set_floor_as_origin = True
         self.frame_number = -1
         self.timestamp = 0
+        self.grab_wall_ms = 0.0
+        self.depth_settings = DepthStreamSettings()
+        self.last_depth_publish = 0.0
+        self.last_jpeg_publish = 0.0
+        self.last_motion_at = time.time()
+        self.prev_pose: Optional[tuple] = None
 
     async def init(self):
         status = self.zed.open(self.init_params)
@@ -66,9 +136,24 @@ class Node(RabbitNode):
         if status != sl.ERROR_CODE.SUCCESS:
             raise RuntimeError(f"Failed to enable positional tracking: {status}")
 
-        await self.publish_camera_intrinsics()
-        await self.init_camera_settings()
+        self.loop = asyncio.get_running_loop()
+
+        # Steady-state capture buffer: retrieve_image_into lands every frame
+        # here instead of allocating a fresh array 30 times a second
+        resolution = self.zed.get_camera_information().camera_configuration.resolution
+        self.image_bgra = np.empty((resolution.height, resolution.width, 4), np.uint8)
+
+        # Independent KV round trips and GPU slot setup run concurrently;
+        # each costs a broker round trip and none depends on another
+        await asyncio.gather(
+            self.publish_camera_intrinsics(),
+            self.init_gpu_depth(),
+            self.init_camera_settings(),
+            self.init_depth_stream_settings(),
+        )
+        self.init_video_stream()
         await self.watch_kv(self.CAMERA_SETTINGS_KEY, self.on_camera_settings_update)
+        await self.watch_kv(self.DEPTH_STREAM_KEY, self.on_depth_stream_update)
         await self.async_task(self.capture_loop)
 
         self.set_interval(self.publish_depth, 1 / self.camera_fps)
@@ -76,7 +161,53 @@ class Node(RabbitNode):
         self.set_interval(self.publish_pose, 1 / self.camera_fps)
         self.set_interval(self.nc.flush, 1 / self.camera_fps)
 
+    def init_video_stream(self):
+        # NVENC takes the RGB stream off the CPU entirely: frames go straight into
+        # the hardware encoder and an H.264 elementary stream goes out over NATS.
+        # Per-frame JPEG on rabbit.zed.frame stays as the fallback path.
+        if not GSTREAMER_AVAILABLE:
+            self.logger.info("Video stream disabled, GStreamer not available")
+            return
+
+        camera_info = self.zed.get_camera_information()
+        resolution = camera_info.camera_configuration.resolution
+
+        self.video_encoder = NvencEncoder(
+            width=resolution.width,
+            height=resolution.height,
+            fps=self.camera_fps,
+            on_chunk=self.on_video_chunk,
+        )
+        self.logger.info(
+            f"NVENC video stream enabled: {resolution.width}x{resolution.height}@{self.camera_fps} h264"
+        )
+
+    def on_video_chunk(self, data: bytes, is_keyframe: bool):
+        # Called from the GStreamer streaming thread
+        asyncio.run_coroutine_threadsafe(
+            self.publish_video_chunk(data, is_keyframe), self.loop
+        )
+
+    async def publish_video_chunk(self, data: bytes, is_keyframe: bool):
+        await self.publish_sensor(
+            "rabbit.zed.video",
+            data,
+            headers={
+                "codec": self.video_encoder.codec,
+                "width": str(self.video_encoder.width),
+                "height": str(self.video_encoder.height),
+                "frame_number": str(self.frame_number),
+                "timestamp": str(self.timestamp),
+                "keyframe": "1" if is_keyframe else "0",
+                "t_grab": str(self.grab_wall_ms),
+                "t_publish": str(time.time() * 1000),
+            },
+        )
+
     async def close(self):
+        if self.video_encoder is not None:
+            self.video_encoder.close()
+
         self.zed.close()
 
     async def publish_camera_intrinsics(self):
@@ -113,6 +244,39 @@ class Node(RabbitNode):
             settings = CameraSettings.model_validate_json(entry.value)
             self.set_camera_settings(settings)
 
+    async def init_depth_stream_settings(self):
+        try:
+            entry = await self.kv.get(self.DEPTH_STREAM_KEY)
+            self.apply_depth_stream_settings(
+                DepthStreamSettings.model_validate_json(entry.value)
+            )
+            self.logger.info("Depth stream settings loaded from KeyValue store")
+        except KeyNotFoundError:
+            await self.kv.put(
+                self.DEPTH_STREAM_KEY, self.depth_settings.model_dump_json().encode()
+            )
+            self.logger.info(
+                f"Depth stream settings not found, initializing defaults: "
+                f"{self.depth_settings.model_dump()}"
+            )
+
+    async def on_depth_stream_update(self, entry: KeyValue.Entry):
+        if entry.value is not None:
+            self.apply_depth_stream_settings(
+                DepthStreamSettings.model_validate_json(entry.value)
+            )
+
+    def apply_depth_stream_settings(self, settings: DepthStreamSettings):
+        if (settings.width, settings.height) != (
+            self.depth_settings.width,
+            self.depth_settings.height,
+        ):
+            self.depth_f32 = np.empty((settings.height, settings.width), np.float32)
+            self.depth_u16 = np.empty((settings.height, settings.width), np.uint16)
+
+        self.depth_settings = settings
+        self.logger.info(f"Applied depth stream settings: {settings.model_dump()}")
+
     async def capture_loop(self):
         status = self.zed.grab(self.runtime_params)
         if status != sl.ERROR_CODE.SUCCESS:
@@ -122,8 +286,9 @@ class Node(RabbitNode):
         self.timestamp = self.zed.get_timestamp(
             sl.TIME_REFERENCE.IMAGE
         ).get_nanoseconds()
+        self.grab_wall_ms = time.time() * 1000
 
-        status = self.zed.retrieve_image(self.image, sl.VIEW.LEFT)
+        status = self.zed.retrieve_image_into(self.image, self.image_bgra, sl.VIEW.LEFT)
         if status != sl.ERROR_CODE.SUCCESS:
             raise RuntimeError(f"Failed to retrieve RGB image: {status}")
 
@@ -135,13 +300,42 @@ class Node(RabbitNode):
                 orientation=self.pose.get_orientation().get(),
                 frame_number=self.frame_number,
                 timestamp=self.timestamp,
-            ).model_dump_json()
+            )
 
-            await self.nc.publish("rabbit.zed.pose", pose.encode())
+            self.detect_motion(pose)
+            await self.publish_sensor("rabbit.zed.pose_bin", pack_pose(pose))
+            await self.publish_sensor("rabbit.zed.pose", pose.model_dump_json().encode())
+
+    def detect_motion(self, pose: Pose):
+        # Feeds the depth motion gate: while consecutive poses agree to within
+        # a few millimeters the scene in front of a static robot is static too,
+        # and publish_depth drops to the keep-alive rate
+        current = (np.array(pose.translation), np.array(pose.orientation))
+        if self.prev_pose is not None:
+            translation = float(np.linalg.norm(current[0] - self.prev_pose[0]))
+            # 1 - |q1·q2| is ~half the squared rotation half-angle; cheap and
+            # monotonic, which is all a threshold needs
+            rotation = 1.0 - abs(float(np.dot(current[1], self.prev_pose[1])))
+            if (
+                translation > self.STATIONARY_TRANSLATION_M
+                or rotation > self.STATIONARY_ROTATION
+            ):
+                self.last_motion_at = time.time()
+        self.prev_pose = current
 
     async def publish_image(self):
-        frame_data = self.image.get_data()
+        frame_data = self.image_bgra
         frame_number = self.frame_number
+        t_grab = self.grab_wall_ms
+
+        if self.video_encoder is not None:
+            await asyncio.to_thread(self.video_encoder.push_frame, frame_data)
+            # JPEG stays alive as the documented fallback for viewers without
+            # WebCodecs, but decimated so NVENC carries the full frame rate
+            now = time.time()
+            if now - self.last_jpeg_publish < 1 / self.JPEG_FALLBACK_RATE_HZ:
+                return
+            self.last_jpeg_publish = now
 
         async def encode_publish():
             frame_rgb = np.ascontiguousarray(frame_data[:, :, :3])
@@ -155,7 +349,9 @@ class Node(RabbitNode):
             if not success:
                 raise RuntimeError("Failed to encode RGB image")
 
-            await self.nc.publish(
+            t_encode = time.time() * 1000
+
+            await self.publish_sensor(
                 "rabbit.zed.frame",
                 buffer.tobytes(),
                 headers={
@@ -164,34 +360,162 @@ class Node(RabbitNode):
                     "height": str(frame_rgb.shape[0]),
                     "frame_number": str(frame_number),
                     "timestamp": str(self.timestamp),
+                    "t_grab": str(t_grab),
+                    "t_encode": str(t_encode),
+                    "t_publish": str(time.time() * 1000),
                 },
             )
 
         await asyncio.create_task(encode_publish())
 
-    async def publish_depth(self):
+    async def init_gpu_depth(self):
+        # Same-host handoff to the nvblox node: the depth frame stays on the GPU and
+        # consumers map it through CUDA IPC instead of decoding it off the network.
+        # The slots are exported once; publish_depth only rotates between them.
+        if not TORCH_AVAILABLE:
+            # The handoff is the intended steady-state path on the robot; a
+            # missing torch install is a deployment problem, not a quiet
+            # fallback, so make it unmissable in the logs
+            self.logger.error(
+                "GPU depth handoff disabled: torch is not installed "
+                "(see docker/Dockerfile.zed); falling back to CPU depth publishing"
+            )
+            return
+
+        if not torch.cuda.is_available():
+            raise RuntimeError(
+                "torch is installed but CUDA is unavailable; "
+                "GPU depth handoff cannot initialize"
+            )
+
+        # Each slot is the frame as H*W floats plus one trailing stamp element
+        # carrying the producer's frame number, so a consumer can detect a
+        # slot that was recycled between publish and clone
+        self.depth_gpu_slots = [
+            torch.zeros(
+                self.DEPTH_HEIGHT * self.DEPTH_WIDTH + 1,
+                dtype=torch.float32,
+                device="cuda",
+            )
+            for _ in range(self.DEPTH_GPU_SLOTS)
+        ]
+
+        handles = [export_cuda_tensor(slot) for slot in self.depth_gpu_slots]
+        await self.kv.put(self.DEPTH_GPU_HANDLES_KEY, pickle.dumps(handles))
+        self.logger.info(
+            f"GPU depth handoff enabled with {self.DEPTH_GPU_SLOTS} IPC slots"
+        )
+
+    async def publish_depth_gpu(self):
         status = self.zed.retrieve_measure(
+            self.depth_gpu,
+            sl.MEASURE.DEPTH,
+            mem_type=sl.MEM.GPU,
+            resolution=sl.Resolution(width=self.DEPTH_WIDTH, height=self.DEPTH_HEIGHT),
+        )
+        if status != sl.ERROR_CODE.SUCCESS:
+            raise RuntimeError(f"Failed to retrieve GPU depth image: {status}")
+
+        depth = torch.from_dlpack(self.depth_gpu.get_data(memory_type=sl.MEM.GPU))
+
+        slot = self.depth_gpu_slot
+        self.depth_gpu_slot = (slot + 1) % self.DEPTH_GPU_SLOTS
+        slot_tensor = self.depth_gpu_slots[slot]
+        frame_view = slot_tensor[:-1].view(self.DEPTH_HEIGHT, self.DEPTH_WIDTH)
+        torch.nan_to_num(depth, nan=0.0, posinf=0.0, neginf=0.0, out=frame_view)
+        # Stamp after the frame write; consumers clone first and check the
+        # stamp second, so a recycled slot is dropped instead of integrating
+        # depth against the wrong pose
+        slot_tensor[-1] = float(self.frame_number % self.GPU_SLOT_STAMP_MOD)
+        torch.cuda.synchronize()
+
+        await self.publish_sensor(
+            "rabbit.zed.depth_gpu",
+            b"",
+            headers={
+                "slot": str(slot),
+                "w": str(self.DEPTH_WIDTH),
+                "h": str(self.DEPTH_HEIGHT),
+                "frame_number": str(self.frame_number),
+                "timestamp": str(self.timestamp),
+            },
+        )
+
+    def depth_rate_gate(self) -> bool:
+        """True when this tick should publish depth.
+
+        Upper-bounds the stream at rate_hz, and once the robot has been
+        stationary for STATIONARY_AFTER_S decimates to idle_rate_hz — late
+        joiners still get a frame within 1/idle_rate_hz seconds.
+        """
+        now = time.time()
+        moving = now - self.last_motion_at < self.STATIONARY_AFTER_S
+        rate = self.depth_settings.rate_hz if moving else self.depth_settings.idle_rate_hz
+        if now - self.last_depth_publish < 1 / rate:
+            return False
+
+        self.last_depth_publish = now
+        return True
+
+    async def publish_depth(self):
+        if not self.depth_rate_gate():
+            return
+
+        if self.depth_gpu_slots is not None:
+            # IPC slots are fixed-size mappings negotiated at startup, so the
+            # GPU path honors the rate gate but not resolution/ROI requests
+            await self.publish_depth_gpu()
+            return
+
+        settings = self.depth_settings
+        status = self.zed.retrieve_measure_into(
             self.depth,
+            self.depth_f32,
             sl.MEASURE.DEPTH,
-            resolution=sl.Resolution(width=640, height=480),
+            resolution=sl.Resolution(width=settings.width, height=settings.height),
         )
         if status != sl.ERROR_CODE.SUCCESS:
             raise RuntimeError(f"Failed to retrieve depth image: {status}")
 
-        depth_data = self.depth.get_data()
+        depth_data = self.depth_f32
+        roi_x, roi_y = 0, 0
+
+        if settings.roi_width > 0 and settings.roi_height > 0:
+            roi_x = min(settings.roi_x, settings.width - 1)
+            roi_y = min(settings.roi_y, settings.height - 1)
+            depth_data = depth_data[
+                roi_y : roi_y + settings.roi_height,
+                roi_x : roi_x + settings.roi_width,
+            ]
+
+        if depth_pack is not None and depth_data.shape == self.depth_u16.shape:
+            # Single fused pass into a reused buffer instead of four NumPy passes
+            depth_pack.quantize_depth(
+                np.ascontiguousarray(depth_data), self.depth_u16, self.MAX_DEPTH_M
+            )
+            u16 = self.depth_u16
+        else:
+            d = np.nan_to_num(depth_data, nan=0.0, posinf=0.0, neginf=0.0)
+            d = np.clip(d, 0.0, self.MAX_DEPTH_M)
+            u16 = np.ascontiguousarray((d * 1000.0).astype(np.uint16))
 
-        d = np.nan_to_num(depth_data, nan=0.0, posinf=0.0, neginf=0.0)
-        d = np.clip(d, 0.0, 16.0)
-        u16 = (d * 1000.0).astype(np.uint16)
-        compressed = lz4.frame.compress(u16.tobytes())
+        compressed = lz4.frame.compress(u16)
 
-        await self.nc.publish(
+        await self.publish_sensor(
             "rabbit.zed.depth",
             compressed,
             headers={
                 "enc": "DEPTH_MM_U16_LZ4",
-                "w": "640",
-                "h": "480",
+                "w": str(u16.shape[1]),
+                "h": str(u16.shape[0]),
+                # Pre-crop retrieve resolution: consumers scale the camera
+                # intrinsics by full_w/full_h and shift the principal point
+                # by the ROI origin
+                "full_w": str(settings.width),
+                "full_h": str(settings.height),
+                "roi_x": str(roi_x),
+                "roi_y": str(roi_y),
+                "frame_number": str(self.frame_number),
                 "timestamp": str(self.timestamp),
             },
         )
@@ -2621,6 +2621,9 @@ class Mat:
     def get_data(self, memory_type = MEM.CPU, deep_copy = False) -> np.array:
         return np.array()
 
+    def copy_into(self, dst, memory_type = MEM.CPU) -> ERROR_CODE:
+        return ERROR_CODE()
+
     def get_step_bytes(self, memory_type = MEM.CPU) -> int:
         return int()
 
@@ -4272,6 +4275,12 @@ class Camera:
     def retrieve_measure(self, py_mat, measure: MEASURE = MEASURE.DEPTH, mem_type: MEM = MEM.CPU, resolution =  None) -> ERROR_CODE:
         return ERROR_CODE()
 
+    def retrieve_image_into(self, py_mat, dst, view: VIEW = VIEW.LEFT, mem_type: MEM = MEM.CPU, resolution =  None) -> ERROR_CODE:
+        return ERROR_CODE()
+
+    def retrieve_measure_into(self, py_mat, dst, measure: MEASURE = MEASURE.DEPTH, mem_type: MEM = MEM.CPU, resolution =  None) -> ERROR_CODE:
+        return ERROR_CODE()
+
     def set_region_of_interest(self, py_mat, modules =  [MODULE.ALL]) -> ERROR_CODE:
         return ERROR_CODE()
 
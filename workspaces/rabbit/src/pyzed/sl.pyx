@@ -6900,8 +6900,92 @@ cdef class Mat:
             memptr = cp.cuda.MemoryPointer(mem, offset=0)
             arr = cp.ndarray(shape, dtype=dtype, memptr=memptr, strides=strides)
 
+        elif memory_type.value == MEM.GPU.value:
+            raise RuntimeError("MEM.GPU requires cupy, which is not installed.")
+
         return arr
 
+    ##
+    # Copies the sl.Mat contents into a caller-owned, preallocated buffer.
+    # The destination must expose the NumPy \b __array_interface__ ([MEM.CPU](\ref MEM)) or the
+    # \b __cuda_array_interface__ ([MEM.GPU](\ref MEM), e.g. a torch CUDA tensor), be C-contiguous,
+    # and match the sl.Mat shape and element size exactly. Rows are packed tight on the
+    # destination side even when the sl.Mat carries row padding.
+    # \param dst : Destination buffer (NumPy array, torch tensor, ...).
+    # \param memory_type : Which memory should be read. Default: [MEM.CPU](\ref MEM).
+    # \return [sl.ERROR_CODE.SUCCESS](\ref ERROR_CODE) if everything went well, [sl.ERROR_CODE.FAILURE](\ref ERROR_CODE) otherwise.
+    # \note Unlike \ref get_data() with \b deep_copy, no allocation happens per call,
+    # so a steady-state buffer can be reused across frames.
+    def copy_into(self, dst, memory_type=MEM.CPU) -> ERROR_CODE:
+
+        if not isinstance(memory_type, MEM):
+            raise TypeError("Argument is not of MEM type.")
+
+        if memory_type.value == MEM.BOTH.value:
+            raise ValueError("MEM.BOTH is not supported for copy_into() method.")
+
+        if self.get_memory_type().value != memory_type.value and self.get_memory_type().value != MEM.BOTH.value:
+            raise ValueError("Provided MEM type doesn't match Mat's memory_type.")
+
+        if memory_type.value == MEM.CPU.value:
+            interface = getattr(dst, "__array_interface__", None)
+            if interface is None:
+                raise TypeError("CPU destination must expose __array_interface__ (e.g. a NumPy array).")
+        else:
+            interface = getattr(dst, "__cuda_array_interface__", None)
+            if interface is None:
+                raise TypeError("GPU destination must expose __cuda_array_interface__ (e.g. a torch CUDA tensor).")
+
+        itemsize = None
+        if self.mat.getDataType() in (c_MAT_TYPE.U8_C1, c_MAT_TYPE.U8_C2, c_MAT_TYPE.U8_C3, c_MAT_TYPE.U8_C4):
+            itemsize = 1
+        elif self.mat.getDataType() in (c_MAT_TYPE.F32_C1, c_MAT_TYPE.F32_C2, c_MAT_TYPE.F32_C3, c_MAT_TYPE.F32_C4):
+            itemsize = sizeof(float)
+        elif self.mat.getDataType() == c_MAT_TYPE.U16_C1:
+            itemsize = sizeof(ushort)
+        else:
+            raise RuntimeError("Unknown Mat data_type value: {0}".format(<int>self.mat.getDataType()))
+
+        if self.mat.getChannels() == 1:
+            expected_shape = (self.mat.getHeight(), self.mat.getWidth())
+        else:
+            expected_shape = (self.mat.getHeight(), self.mat.getWidth(), self.mat.getChannels())
+
+        if tuple(interface["shape"]) != expected_shape:
+            raise ValueError("Destination shape {0} doesn't match Mat shape {1}.".format(tuple(interface["shape"]), expected_shape))
+
+        if int(interface["typestr"][2:]) != itemsize:
+            raise ValueError("Destination element size doesn't match Mat element size ({0} bytes).".format(itemsize))
+
+        if interface.get("strides") is not None:
+            raise ValueError("Destination buffer must be C-contiguous.")
+
+        cdef size_t src_ptr = <size_t>getPointerUchar1(self.mat, <c_MEM>(<int>memory_type.value))
+        cdef size_t dst_ptr
+        cdef size_t row_bytes = self.mat.getWidthBytes()
+        cdef size_t src_step = self.mat.getStepBytes(<c_MEM>(<int>memory_type.value))
+        cdef size_t height = self.mat.getHeight()
+        cdef size_t row
+
+        if memory_type.value == MEM.CPU.value:
+            data_ptr, read_only = interface["data"]
+            if read_only:
+                raise ValueError("Destination buffer is read-only.")
+            dst_ptr = <size_t>data_ptr
+            if src_step == row_bytes:
+                memcpy(<void*>dst_ptr, <void*>src_ptr, row_bytes * height)
+            else:
+                for row in range(height):
+                    memcpy(<void*>(dst_ptr + row * row_bytes), <void*>(src_ptr + row * src_step), row_bytes)
+        else:
+            if not CUPY_AVAILABLE:
+                raise RuntimeError("cupy is required for copy_into() on GPU memory.")
+            dst_ptr = <size_t>interface["data"][0]
+            TRANSFER_KIND_GPU_GPU = 3
+            cp.cuda.runtime.memcpy2D(dst_ptr, row_bytes, src_ptr, src_step, row_bytes, height, TRANSFER_KIND_GPU_GPU)
+
+        return ERROR_CODE.SUCCESS
+
     ##
     # Returns the memory step in bytes (size of one pixel row).
     # \param memory_type : Specifies whether you want [sl.MEM.CPU](\ref MEM) or [sl.MEM.GPU](\ref MEM) step.\n Default: [sl.MEM.CPU](\ref MEM) (you cannot change the default value)
@@ -11014,6 +11098,43 @@ cdef class Camera:
             err = self.camera.retrieveMeasure(py_mat.mat, c_measure, c_mem, resolution.resolution)
         return _error_code_cache.get(<int>err, ERROR_CODE.FAILURE)
 
+    ##
+    # Variant of \ref retrieve_image() that lands the image in a caller-owned buffer.
+    #
+    # The provided sl.Mat is only the SDK-side staging area (its memory is reused across
+    # calls once allocated); the pixels are then copied into \b dst via \ref Mat.copy_into(),
+    # so no per-frame allocation happens on the Python side — a capture loop can retrieve
+    # every frame into the same steady-state buffer.
+    # \param py_mat[out] : The \ref sl.Mat used as staging storage.
+    # \param dst[out] : Preallocated destination buffer matching the image shape and element size (NumPy array or, for [MEM.GPU](\ref MEM), any object exposing \b __cuda_array_interface__).
+    # \param view[in] : Defines the image you want (see \ref VIEW). Default: \ref VIEW "VIEW.LEFT".
+    # \param mem_type[in] : Defines on which memory the image should be allocated. Default: \ref MEM "MEM.CPU".
+    # \param resolution[in] : If specified, defines the \ref Resolution of the output. If set to \ref Resolution "Resolution(0,0)", the camera resolution will be taken. Default: (0,0).
+    # \return \ref ERROR_CODE "ERROR_CODE.SUCCESS" if the method succeeded.
+    def retrieve_image_into(self, Mat py_mat, dst, view: VIEW = VIEW.LEFT, mem_type: MEM = MEM.CPU, Resolution resolution = None) -> ERROR_CODE:
+        status = self.retrieve_image(py_mat, view, mem_type, resolution)
+        if status != ERROR_CODE.SUCCESS:
+            return status
+        return py_mat.copy_into(dst, mem_type)
+
+    ##
+    # Variant of \ref retrieve_measure() that lands the measure in a caller-owned buffer.
+    #
+    # See \ref retrieve_image_into() — same contract, for measures: the sl.Mat is only
+    # staging storage and \b dst receives the data through \ref Mat.copy_into() without
+    # any per-frame allocation.
+    # \param py_mat[out] : The \ref sl.Mat used as staging storage.
+    # \param dst[out] : Preallocated destination buffer matching the measure shape and element size (NumPy array or, for [MEM.GPU](\ref MEM), any object exposing \b __cuda_array_interface__).
+    # \param measure[in] : Defines the measure you want (see \ref MEASURE). Default: \ref MEASURE "MEASURE.DEPTH".
+    # \param mem_type[in] : Defines on which memory the measure should be allocated. Default: \ref MEM "MEM.CPU".
+    # \param resolution[in] : If specified, defines the \ref Resolution of the output. If set to \ref Resolution "Resolution(0,0)", the camera resolution will be taken. Default: (0,0).
+    # \return \ref ERROR_CODE "ERROR_CODE.SUCCESS" if the method succeeded.
+    def retrieve_measure_into(self, Mat py_mat, dst, measure: MEASURE = MEASURE.DEPTH, mem_type: MEM = MEM.CPU, Resolution resolution = None) -> ERROR_CODE:
+        status = self.retrieve_measure(py_mat, measure, mem_type, resolution)
+        if status != ERROR_CODE.SUCCESS:
+            return status
+        return py_mat.copy_into(dst, mem_type)
+
     ##
     # Defines a region of interest to focus on for all the SDK, discarding other parts.
     # \param roi_mask : The \ref Mat defining the requested region of interest, pixels lower than 127 will be discarded from all modules: depth, positional tracking, etc.
@@ -181,6 +181,32 @@ export const useKVSubscribe = () => {
     return subscribe;
 };
 
+export type BinaryPose = {
+    translation: [number, number, number];
+    orientation: [number, number, number, number];
+    frameNumber: number;
+    timestamp: bigint;
+};
+
+// Fixed-layout pose published on rabbit.zed.pose_bin: translation (3×f32),
+// orientation quaternion (4×f32), frame_number (u32), timestamp ns (i64).
+// 40 bytes little-endian, mirrors POSE_STRUCT in the rabbit lib/model.py.
+export const decodePose = (data: Uint8Array): BinaryPose => {
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+
+    return {
+        translation: [view.getFloat32(0, true), view.getFloat32(4, true), view.getFloat32(8, true)],
+        orientation: [
+            view.getFloat32(12, true),
+            view.getFloat32(16, true),
+            view.getFloat32(20, true),
+            view.getFloat32(24, true),
+        ],
+        frameNumber: view.getUint32(28, true),
+        timestamp: view.getBigInt64(32, true),
+    };
+};
+
 const connect = async () => {
     L.info('Connecting to NATS server...');
 
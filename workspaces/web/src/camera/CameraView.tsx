@@ -7,10 +7,11 @@ import { useCameraStream } from './useCamera.tsx';
 
 type CameraViewProps = {
     subject: string;
+    videoSubject?: string;
 };
 
-export const CameraView: React.FC<CameraViewProps> = ({ subject }) => {
-    const { canvas, stats } = useCameraStream({ subject });
+export const CameraView: React.FC<CameraViewProps> = ({ subject, videoSubject }) => {
+    const { canvas, stats } = useCameraStream({ subject, videoSubject });
 
     const getHeader = () => {
         if (stats == null) {
@@ -0,0 +1,89 @@
+import { css } from '@emotion/css';
+import React from 'react';
+import z from 'zod';
+
+import { useNats } from '../app/NatsProvider.tsx';
+
+const STAGE_ORDER = ['encode', 'publish', 'transport', 'decode', 'render', 'end_to_end'];
+
+export const LatencyReport: React.FC = () => {
+    const { nc } = useNats();
+    const [report, setReport] = React.useState<LatencyReportMessage | null>(null);
+
+    React.useEffect(() => {
+        const subscription = nc.subscribe('rabbit.latency.report', {
+            callback: (_, msg) => {
+                setReport(LatencyReportMessage.parse(msg.json()));
+            },
+        });
+
+        return () => subscription.unsubscribe();
+    }, [nc]);
+
+    if (report == null) {
+        return <div>waiting for traces...</div>;
+    }
+
+    const stages = STAGE_ORDER.filter((stage) => report[stage] != null);
+
+    return (
+        <table
+            className={css`
+                width: 100%;
+                font-size: 12px;
+                font-variant-numeric: tabular-nums;
+                border-collapse: collapse;
+
+                th {
+                    text-align: right;
+                    opacity: 0.6;
+                    font-weight: normal;
+                }
+
+                th:first-child {
+                    text-align: left;
+                }
+
+                td {
+                    text-align: right;
+                }
+
+                td:first-child {
+                    text-align: left;
+                }
+            `}>
+            <thead>
+                <tr>
+                    <th>stage</th>
+                    <th>p50</th>
+                    <th>p95</th>
+                    <th>max</th>
+                </tr>
+            </thead>
+            <tbody>
+                {stages.map((stage) => {
+                    const row = report[stage]!;
+                    return (
+                        <tr key={stage}>
+                            <td>{stage}</td>
+                            <td>{row.p50_ms.toFixed(1)}ms</td>
+                            <td>{row.p95_ms.toFixed(1)}ms</td>
+                            <td>{row.max_ms.toFixed(1)}ms</td>
+                        </tr>
+                    );
+                })}
+            </tbody>
+        </table>
+    );
+};
+
+const StageStats = z.object({
+    count: z.number(),
+    mean_ms: z.number(),
+    p50_ms: z.number(),
+    p95_ms: z.number(),
+    max_ms: z.number(),
+});
+
+type LatencyReportMessage = z.infer<typeof LatencyReportMessage>;
+const LatencyReportMessage = z.record(z.string(), StageStats);
@@ -16,7 +16,11 @@ type Stats = {
     subject: string;
 };
 
-export const useCameraStream = ({ subject }: { subject: string }) => {
+// JPEG frames are suppressed while H.264 is flowing; if no video message
+// arrives for this long (encoder restart, zed restart) the fallback resumes
+const VIDEO_STALE_MS = 2000;
+
+export const useCameraStream = ({ subject, videoSubject }: { subject: string; videoSubject?: string }) => {
     const { nc } = useNats();
     const canvas = React.useRef<HTMLCanvasElement>(null);
     const [stats, setStats] = React.useState<Stats | null>(null);
@@ -26,6 +30,7 @@ export const useCameraStream = ({ subject }: { subject: string }) => {
 
         let bytes = 0;
         let type = 'unknown';
+        let lastVideoAt = 0;
 
         let tick = {
             now: Date.now(),
@@ -59,7 +64,7 @@ export const useCameraStream = ({ subject }: { subject: string }) => {
         const subscription = nc.subscribe(subject, {
             callback: (_, msg) => {
                 const ctx = canvas.current?.getContext('2d');
-                if (canvas.current == null || ctx == null) {
+                if (canvas.current == null || ctx == null || Date.now() - lastVideoAt < VIDEO_STALE_MS) {
                     return;
                 }
 
@@ -74,12 +79,31 @@ export const useCameraStream = ({ subject }: { subject: string }) => {
                     canvas.current.height = headers.height;
                 }
 
+                const t_receive = Date.now();
                 const blob = new Blob([msg.data], { type: headers.type });
                 const url = URL.createObjectURL(blob);
 
                 img.onload = () => {
+                    const t_decode = Date.now();
                     ctx.drawImage(img, 0, 0);
                     URL.revokeObjectURL(url);
+
+                    // Stage trace for the latency collector, sampled to keep
+                    // the reverse channel negligible
+                    if (headers.t_grab != null && headers.frame_number % 10 === 0) {
+                        nc.publish(
+                            'rabbit.latency.trace',
+                            JSON.stringify({
+                                frame_number: headers.frame_number,
+                                t_grab: headers.t_grab,
+                                t_encode: headers.t_encode,
+                                t_publish: headers.t_publish,
+                                t_receive,
+                                t_decode,
+                                t_render: Date.now(),
+                            }),
+                        );
+                    }
                 };
 
                 img.onerror = () => {
@@ -97,8 +121,108 @@ export const useCameraStream = ({ subject }: { subject: string }) => {
 
         L.info('Subscribed to NATS', { subject });
 
+        // Hardware decode path: H.264 chunks from the zed node's NVENC stream
+        // go straight through a WebCodecs VideoDecoder and decoded VideoFrames
+        // are drawn onto the canvas — no Blob, object URL, or software JPEG
+        // decode per frame. The JPEG/Image path above stays as the fallback
+        // for browsers without WebCodecs and for when NVENC is unavailable.
+        let decoder: VideoDecoder | null = null;
+        let configured = false;
+        // Chunks decode in order, so a FIFO of submitted traces lines up with
+        // decoder outputs for the render stamp
+        let pendingTraces: Array<Record<string, number>> = [];
+
+        const resetDecoder = () => {
+            if (decoder != null && decoder.state !== 'closed') {
+                decoder.close();
+            }
+            decoder = null;
+            configured = false;
+            pendingTraces = [];
+        };
+
+        const videoSubscription =
+            videoSubject != null && 'VideoDecoder' in window
+                ? nc.subscribe(videoSubject, {
+                      callback: (_, msg) => {
+                          const ctx = canvas.current?.getContext('2d');
+                          if (canvas.current == null || ctx == null) {
+                              return;
+                          }
+
+                          const headers = util.parseNatsHeaders(VideoHeader, msg);
+                          if (canvas.current.width !== headers.width || canvas.current.height !== headers.height) {
+                              canvas.current.width = headers.width;
+                              canvas.current.height = headers.height;
+                          }
+
+                          if (decoder == null) {
+                              decoder = new VideoDecoder({
+                                  output: (frame) => {
+                                      const trace = pendingTraces.shift();
+                                      ctx.drawImage(frame, 0, 0);
+                                      frame.close();
+
+                                      if (trace != null && trace.sample === 1) {
+                                          delete trace.sample;
+                                          trace.t_render = Date.now();
+                                          nc.publish('rabbit.latency.trace', JSON.stringify(trace));
+                                      }
+                                  },
+                                  error: (e) => {
+                                      L.error('VideoDecoder error, resetting', e);
+                                      resetDecoder();
+                                  },
+                              });
+                          }
+
+                          if (!configured) {
+                              // Annex B chunks carry their parameter sets in-band,
+                              // so no description is needed — but decoding can only
+                              // start at a keyframe
+                              if (headers.keyframe !== 1) {
+                                  return;
+                              }
+
+                              decoder.configure({
+                                  codec: headers.codec === 'h265' ? 'hvc1.1.6.L93.B0' : 'avc1.42E01E',
+                                  optimizeForLatency: true,
+                              });
+                              configured = true;
+                          }
+
+                          pendingTraces.push({
+                              frame_number: headers.frame_number,
+                              t_grab: headers.t_grab ?? 0,
+                              t_publish: headers.t_publish ?? 0,
+                              t_receive: Date.now(),
+                              sample: headers.t_grab != null && headers.frame_number % 10 === 0 ? 1 : 0,
+                          });
+
+                          decoder.decode(
+                              new EncodedVideoChunk({
+                                  type: headers.keyframe === 1 ? 'key' : 'delta',
+                                  timestamp: headers.frame_number * 33_333,
+                                  data: msg.data,
+                              }),
+                          );
+
+                          lastVideoAt = Date.now();
+                          tick.frames += 1;
+                          tick.bytes += msg.data.length;
+                          type = `video/${headers.codec}`;
+                      },
+                  })
+                : null;
+
+        if (videoSubscription != null) {
+            L.info('Subscribed to NATS', { subject: videoSubject });
+        }
+
         return () => {
             subscription.unsubscribe();
+            videoSubscription?.unsubscribe();
+            resetDecoder();
             clearInterval(intervalId);
 
             L.info('Unsubscribed from NATS', { subject });
@@ -108,9 +232,22 @@ export const useCameraStream = ({ subject }: { subject: string }) => {
     return { canvas, stats };
 };
 
+const VideoHeader = z.object({
+    codec: z.string(),
+    width: z.coerce.number().int(),
+    height: z.coerce.number().int(),
+    frame_number: z.coerce.number().int(),
+    keyframe: z.coerce.number().int(),
+    t_grab: z.coerce.number().optional(),
+    t_publish: z.coerce.number().optional(),
+});
+
 const MessageHeader = z.object({
     type: z.string(),
     width: z.coerce.number().int(),
     height: z.coerce.number().int(),
     frame_number: z.coerce.number().int(),
+    t_grab: z.coerce.number().optional(),
+    t_encode: z.coerce.number().optional(),
+    t_publish: z.coerce.number().optional(),
 });
@@ -3,17 +3,25 @@ import React from 'react';
 
 import { useNats } from '../app/NatsProvider.tsx';
 import { type DualSenseState, type StickState, useGamepad } from './GamepadProvider.tsx';
+import { JOY_BYTE_LENGTH, encodeJoy } from './joy.ts';
 
 export const GamepadController: React.FC = () => {
     const { nc } = useNats();
     const { gamepad, subscribe } = useGamepad();
     const [state, setState] = React.useState<DualSenseState | null>(null);
+    const buffer = React.useRef(new Uint8Array(JOY_BYTE_LENGTH));
+    const debugFrame = React.useRef(0);
 
     React.useEffect(() => {
         return subscribe((state) => {
             setState(state);
-            nc.publish('rabbit.cmd.joy', JSON.stringify(state));
+            nc.publish('rabbit.cmd.joy', encodeJoy(state, buffer.current));
             nc.flush();
+
+            // Full JSON state once a second for inspection from the terminal.
+            if (debugFrame.current++ % 30 === 0) {
+                nc.publish('rabbit.cmd.joy.json', JSON.stringify(state));
+            }
         });
     }, [gamepad, nc]);
 
@@ -0,0 +1,49 @@
+import { type DualSenseState } from './GamepadProvider.tsx';
+
+// Fixed-layout binary joystick command published on rabbit.cmd.joy: left/right
+// stick x/y as i16 scaled by 32767, l2/r2 trigger values as u16 scaled by
+// 65535, and a button bitmask in JOY_BUTTONS order. 14 bytes, little-endian,
+// mirrored by JOY_STRUCT/unpack_joy in the rabbit workspace's lib/model.py.
+export const JOY_BYTE_LENGTH = 14;
+
+export const JOY_BUTTONS = [
+    'cross',
+    'circle',
+    'square',
+    'triangle',
+    'l1',
+    'r1',
+    'l2',
+    'r2',
+    'share',
+    'options',
+    'l3',
+    'r3',
+    'up',
+    'down',
+    'left',
+    'right',
+] as const;
+
+const clamp = (value: number, min: number, max: number) => Math.min(Math.max(value, min), max);
+
+export const encodeJoy = (state: DualSenseState, out: Uint8Array): Uint8Array => {
+    const view = new DataView(out.buffer, out.byteOffset, JOY_BYTE_LENGTH);
+
+    view.setInt16(0, Math.round(clamp(state.sticks.left.x, -1, 1) * 32767), true);
+    view.setInt16(2, Math.round(clamp(state.sticks.left.y, -1, 1) * 32767), true);
+    view.setInt16(4, Math.round(clamp(state.sticks.right.x, -1, 1) * 32767), true);
+    view.setInt16(6, Math.round(clamp(state.sticks.right.y, -1, 1) * 32767), true);
+    view.setUint16(8, Math.round(clamp(state.buttons.l2.value, 0, 1) * 65535), true);
+    view.setUint16(10, Math.round(clamp(state.buttons.r2.value, 0, 1) * 65535), true);
+
+    let buttons = 0;
+    for (let i = 0; i < JOY_BUTTONS.length; i++) {
+        if (state.buttons[JOY_BUTTONS[i]].pressed) {
+            buttons |= 1 << i;
+        }
+    }
+    view.setUint16(12, buttons, true);
+
+    return out;
+};
@@ -3,6 +3,7 @@ import React from 'react';
 
 import { CameraSettings } from '../camera/CameraSettings.tsx';
 import { CameraView } from '../camera/CameraView.tsx';
+import { LatencyReport } from '../camera/LatencyReport.tsx';
 import { GamepadController } from '../controller/GamepadController.tsx';
 import { PointCloud } from '../perception/PointCloud.tsx';
 import { ui } from '../ui/index.ts';
@@ -33,6 +34,9 @@ export const MainLayout: React.FC = () => {
                 <ui.Card header='CAMERA SETTINGS'>
                     <CameraSettings />
                 </ui.Card>
+                <ui.Card header='PIPELINE LATENCY'>
+                    <LatencyReport />
+                </ui.Card>
             </div>
             <div
                 className={css`
@@ -49,7 +53,7 @@ export const MainLayout: React.FC = () => {
                         width: 100%;
                         flex: 1;
                     `}>
-                    <CameraView subject='rabbit.zed.frame' />
+                    <CameraView subject='rabbit.zed.frame' videoSubject='rabbit.zed.video' />
                 </div>
 
                 <div
@@ -3,14 +3,24 @@ import React from 'react';
 import * as THREE from 'three';
 import z from 'zod';
 
-import { useKVSubscribe, useNats } from '../app/NatsProvider.tsx';
+import { type BinaryPose, decodePose, useKVSubscribe, useNats, useObjectStoreSubscribe } from '../app/NatsProvider.tsx';
+import { L } from '../terminal/LogProvider.tsx';
+import { MapMesh, decodeMapMesh } from './mesh.ts';
+import { VoxelInstances, decodeVoxelDelta } from './voxels.ts';
+
+// Mirrors VIEWPORT_STRUCT in node/nvblox.py: camera position (3×f32),
+// column-major view-projection matrix (16×f32), block budget (u32)
+const VIEWPORT_REQUEST_SIZE = 80;
+const VIEWPORT_BLOCK_BUDGET = 2048;
+const VIEWPORT_INTERVAL_MS = 500;
 
 export const PointCloud: React.FC = () => {
-    const { nc } = useNats();
+    const { nc, obj } = useNats();
     const ref = React.useRef<HTMLCanvasElement | null>(null);
     const intrinsics = React.useRef<CameraIntrinsics | null>(null);
     const kv = useKVSubscribe();
-    const [pose, setPose] = React.useState<Pose | null>(null);
+    const objSubscribe = useObjectStoreSubscribe();
+    const [pose, setPose] = React.useState<BinaryPose | null>(null);
 
     React.useLayoutEffect(() => {
         if (!ref.current) {
@@ -35,10 +45,71 @@ export const PointCloud: React.FC = () => {
 
         const camera = new THREE.PerspectiveCamera(60, width / height, 0.1, 1000);
 
+        const voxels = new VoxelInstances(0.05);
+        scene.add(voxels.mesh);
+
+        // Viewport-driven streaming: instead of pulling the whole map, the
+        // client sends its frustum and a block budget and the nvblox node
+        // replies with only the visible blocks, coarsened with distance.
+        // Each reply is keyframe-shaped, so applying it resets the instance
+        // table to exactly what is on screen.
+        const viewProjection = new THREE.Matrix4();
+        const requestViewport = async () => {
+            viewProjection.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+
+            const payload = new DataView(new ArrayBuffer(VIEWPORT_REQUEST_SIZE));
+            payload.setFloat32(0, camera.position.x, true);
+            payload.setFloat32(4, camera.position.y, true);
+            payload.setFloat32(8, camera.position.z, true);
+            viewProjection.elements.forEach((value, i) => payload.setFloat32(12 + i * 4, value, true));
+            payload.setUint32(76, VIEWPORT_BLOCK_BUDGET, true);
+
+            let reply;
+            try {
+                reply = await nc.request('rabbit.nvblox.viewport', new Uint8Array(payload.buffer), {
+                    timeout: 2000,
+                });
+            } catch {
+                // nvblox node not up yet; the next tick retries
+                return;
+            }
+
+            if (reply.data.byteLength > 0) {
+                try {
+                    voxels.apply(decodeVoxelDelta(reply.data), true);
+                } catch (e) {
+                    L.error('Failed to decode viewport reply', e);
+                }
+            }
+        };
+
+        void requestViewport();
+        const viewportTimer = setInterval(() => void requestViewport(), VIEWPORT_INTERVAL_MS);
+
+        const mapMesh = new MapMesh();
+        scene.add(mapMesh.mesh);
+
+        const loadMesh = () =>
+            obj
+                .getBlob('rabbit.nvblox.mesh')
+                .then((data) => mapMesh.update(decodeMapMesh(data)))
+                .catch((e) => L.error('Failed to load map mesh', e));
+
+        void loadMesh();
+        const unbindMeshUpdates = objSubscribe('rabbit.nvblox.mesh', () => loadMesh());
+
+        // The native nvblox node has no object-store client and publishes the
+        // same MESH blob as a core message instead
+        const meshWatcher = nc.subscribe('rabbit.nvblox.mesh.bin', {
+            callback: (_, msg) => {
+                mapMesh.update(decodeMapMesh(msg.data));
+            },
+        });
+
         let poseFrame = 0;
-        const poseWatcher = nc.subscribe('rabbit.zed.pose', {
+        const poseWatcher = nc.subscribe('rabbit.zed.pose_bin', {
             callback: (_, msg) => {
-                const pose = Pose.parse(msg?.json());
+                const pose = decodePose(msg.data);
 
                 const [px, py, pz] = pose.translation;
                 const [qx, qy, qz, qw] = pose.orientation;
@@ -93,6 +164,11 @@ export const PointCloud: React.FC = () => {
             renderer.dispose();
             poseWatcher.unsubscribe();
             cameraIntrinsicWatcher.unsubscribe();
+            clearInterval(viewportTimer);
+            meshWatcher.unsubscribe();
+            unbindMeshUpdates();
+            voxels.dispose();
+            mapMesh.dispose();
         };
     }, [ref.current]);
 
@@ -122,12 +198,6 @@ export const PointCloud: React.FC = () => {
     );
 };
 
-type Pose = z.infer<typeof Pose>;
-const Pose = z.object({
-    translation: z.tuple([z.number(), z.number(), z.number()]),
-    orientation: z.tuple([z.number(), z.number(), z.number(), z.number()]), // x,y,z,w
-});
-
 type CameraIntrinsics = z.infer<typeof CameraIntrinsics>;
 const CameraIntrinsics = z.object({
     fx: z.number(),
@@ -0,0 +1,65 @@
+import * as THREE from 'three';
+
+// Color mesh object from the nvblox node: MESH_HEADER (magic, version,
+// sequence, vertex count, triangle count) followed by float32 vertices,
+// uint8 vertex colors and uint32 triangle indices. Mirrors MESH_HEADER in
+// node/nvblox.py.
+const MESH_HEADER_SIZE = 20;
+
+export type MapMeshData = {
+    sequence: number;
+    vertices: Float32Array;
+    colors: Uint8Array;
+    indices: Uint32Array;
+};
+
+export const decodeMapMesh = (data: Uint8Array): MapMeshData => {
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+
+    if (view.getUint8(0) !== 0x4d || view.getUint8(1) !== 0x45 || view.getUint8(2) !== 0x53 || view.getUint8(3) !== 0x48) {
+        throw new Error('Invalid mesh magic');
+    }
+
+    const sequence = view.getUint32(8, true);
+    const vertexCount = view.getUint32(12, true);
+    const triangleCount = view.getUint32(16, true);
+
+    let offset = MESH_HEADER_SIZE;
+    const vertices = new Float32Array(data.buffer, data.byteOffset + offset, vertexCount * 3);
+    offset += vertexCount * 12;
+    const colors = new Uint8Array(data.buffer, data.byteOffset + offset, vertexCount * 3);
+    offset += vertexCount * 3;
+    const indices = new Uint32Array(data.buffer.slice(data.byteOffset + offset, data.byteOffset + offset + triangleCount * 12));
+
+    return { sequence, vertices, colors, indices };
+};
+
+// Single THREE.Mesh whose buffer geometry is swapped in place on every map
+// update; vertex colors come straight from the uint8 payload (normalized).
+export class MapMesh {
+    public readonly mesh: THREE.Mesh;
+
+    constructor() {
+        this.mesh = new THREE.Mesh(
+            new THREE.BufferGeometry(),
+            new THREE.MeshLambertMaterial({ vertexColors: true, side: THREE.DoubleSide }),
+        );
+        this.mesh.frustumCulled = false;
+    }
+
+    public update(data: MapMeshData) {
+        const geometry = new THREE.BufferGeometry();
+        geometry.setAttribute('position', new THREE.BufferAttribute(data.vertices, 3));
+        geometry.setAttribute('color', new THREE.BufferAttribute(data.colors, 3, true));
+        geometry.setIndex(new THREE.BufferAttribute(data.indices, 1));
+        geometry.computeVertexNormals();
+
+        this.mesh.geometry.dispose();
+        this.mesh.geometry = geometry;
+    }
+
+    public dispose() {
+        this.mesh.geometry.dispose();
+        (this.mesh.material as THREE.Material).dispose();
+    }
+}
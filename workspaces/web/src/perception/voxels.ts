@@ -0,0 +1,200 @@
+import * as THREE from 'three';
+
+// Block-structured voxel map messages from the nvblox node. Keyframes (object
+// store, all blocks) and deltas (rabbit.nvblox.voxels.delta, changed blocks
+// only) share one layout: DELTA_HEADER, removed block entries as 4×i32
+// (index + mapper level), then per block a 4×i32 index/level + f32 voxel size
+// + u32 voxel count followed by float32 positions and uint8 colors. Mirrors
+// DELTA_HEADER/BLOCK_HEADER/REMOVED_BLOCK in node/nvblox.py.
+const DELTA_HEADER_SIZE = 24;
+const BLOCK_HEADER_SIZE = 24;
+const REMOVED_BLOCK_SIZE = 16;
+
+export type VoxelBlock = {
+    key: string;
+    voxelSize: number;
+    positions: Float32Array;
+    colors: Uint8Array;
+};
+
+export type VoxelDelta = {
+    sequence: number;
+    voxelSize: number;
+    removed: string[];
+    blocks: VoxelBlock[];
+};
+
+export const decodeVoxelDelta = (data: Uint8Array): VoxelDelta => {
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+
+    if (view.getUint8(0) !== 0x56 || view.getUint8(1) !== 0x4f || view.getUint8(2) !== 0x58 || view.getUint8(3) !== 0x44) {
+        throw new Error('Invalid voxel delta magic');
+    }
+
+    const sequence = view.getUint32(8, true);
+    const removedCount = view.getUint32(12, true);
+    const changedCount = view.getUint32(16, true);
+    const voxelSize = view.getFloat32(20, true);
+
+    let offset = DELTA_HEADER_SIZE;
+
+    const blockKey = (at: number) =>
+        `${view.getInt32(at, true)},${view.getInt32(at + 4, true)},${view.getInt32(at + 8, true)},${view.getInt32(at + 12, true)}`;
+
+    const removed: string[] = [];
+    for (let i = 0; i < removedCount; i++) {
+        removed.push(blockKey(offset));
+        offset += REMOVED_BLOCK_SIZE;
+    }
+
+    const blocks: VoxelBlock[] = [];
+    for (let i = 0; i < changedCount; i++) {
+        const key = blockKey(offset);
+        const blockVoxelSize = view.getFloat32(offset + 16, true);
+        const count = view.getUint32(offset + 20, true);
+        offset += BLOCK_HEADER_SIZE;
+
+        // Copy instead of viewing in place: the packed uint8 colors of the
+        // previous block leave this offset unaligned for a Float32Array view
+        const positionsStart = data.byteOffset + offset;
+        const positions = new Float32Array(data.buffer.slice(positionsStart, positionsStart + count * 12));
+        offset += count * 12;
+        const colors = new Uint8Array(data.buffer, data.byteOffset + offset, count * 3);
+        offset += count * 3;
+
+        blocks.push({ key, voxelSize: blockVoxelSize, positions, colors });
+    }
+
+    return { sequence, voxelSize, removed, blocks };
+};
+
+// One InstancedMesh for the whole map: blocks own ranges of instance slots and
+// delta messages only rewrite the slots of the blocks they touch, so a 500k
+// voxel map stays a single draw call with no per-voxel JS objects.
+export class VoxelInstances {
+    public readonly mesh: THREE.InstancedMesh;
+
+    private readonly capacity: number;
+    private readonly blockSlots = new Map<string, number[]>();
+    private readonly freeSlots: number[] = [];
+    private highWater = 0;
+    private lastSequence = -1;
+
+    private readonly matrix = new THREE.Matrix4();
+    private readonly scale = new THREE.Vector3();
+    private readonly color = new THREE.Color();
+    private readonly hiddenMatrix = new THREE.Matrix4().makeScale(0, 0, 0);
+    private readonly baseVoxelSize: number;
+
+    constructor(voxelSize: number, capacity = 500_000) {
+        this.capacity = capacity;
+        this.baseVoxelSize = voxelSize;
+
+        const geometry = new THREE.BoxGeometry(voxelSize, voxelSize, voxelSize);
+        const material = new THREE.MeshLambertMaterial();
+
+        this.mesh = new THREE.InstancedMesh(geometry, material, capacity);
+        this.mesh.instanceMatrix.setUsage(THREE.DynamicDrawUsage);
+        this.mesh.instanceColor = new THREE.InstancedBufferAttribute(new Float32Array(capacity * 3), 3);
+        this.mesh.instanceColor.setUsage(THREE.DynamicDrawUsage);
+        this.mesh.count = 0;
+        this.mesh.frustumCulled = false;
+    }
+
+    public apply(delta: VoxelDelta, isKeyframe: boolean) {
+        if (isKeyframe) {
+            if (delta.sequence < this.lastSequence) {
+                return;
+            }
+            this.reset();
+        } else if (delta.sequence <= this.lastSequence && this.lastSequence !== -1) {
+            return;
+        }
+        this.lastSequence = delta.sequence;
+
+        for (const key of delta.removed) {
+            this.releaseBlock(key);
+        }
+
+        for (const block of delta.blocks) {
+            this.releaseBlock(block.key);
+
+            const count = block.positions.length / 3;
+            const slots: number[] = [];
+
+            // Coarse-mapper blocks share the unit geometry, scaled per instance
+            const scale = block.voxelSize / this.baseVoxelSize;
+            this.scale.set(scale, scale, scale);
+
+            for (let i = 0; i < count; i++) {
+                const slot = this.allocateSlot();
+                if (slot == null) {
+                    break;
+                }
+
+                this.matrix.makeTranslation(
+                    block.positions[i * 3],
+                    block.positions[i * 3 + 1],
+                    block.positions[i * 3 + 2],
+                );
+                this.matrix.scale(this.scale);
+                this.mesh.setMatrixAt(slot, this.matrix);
+
+                this.color.setRGB(block.colors[i * 3] / 255, block.colors[i * 3 + 1] / 255, block.colors[i * 3 + 2] / 255);
+                this.mesh.setColorAt(slot, this.color);
+
+                slots.push(slot);
+            }
+
+            if (slots.length > 0) {
+                this.blockSlots.set(block.key, slots);
+            }
+        }
+
+        this.mesh.count = this.highWater;
+        this.mesh.instanceMatrix.needsUpdate = true;
+        if (this.mesh.instanceColor) {
+            this.mesh.instanceColor.needsUpdate = true;
+        }
+    }
+
+    public dispose() {
+        this.mesh.geometry.dispose();
+        (this.mesh.material as THREE.Material).dispose();
+        this.mesh.dispose();
+    }
+
+    private allocateSlot(): number | null {
+        const slot = this.freeSlots.pop();
+        if (slot != null) {
+            return slot;
+        }
+
+        if (this.highWater >= this.capacity) {
+            return null;
+        }
+
+        return this.highWater++;
+    }
+
+    private releaseBlock(key: string) {
+        const slots = this.blockSlots.get(key);
+        if (slots == null) {
+            return;
+        }
+
+        for (const slot of slots) {
+            this.mesh.setMatrixAt(slot, this.hiddenMatrix);
+            this.freeSlots.push(slot);
+        }
+
+        this.blockSlots.delete(key);
+    }
+
+    private reset() {
+        this.blockSlots.clear();
+        this.freeSlots.length = 0;
+        this.highWater = 0;
+        this.mesh.count = 0;
+    }
+}